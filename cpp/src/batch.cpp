@@ -0,0 +1,218 @@
+#include "batch.h"
+
+#include "board.h"
+#include "move.h"
+#include "search.h"
+#include "transposition.h"
+#include "util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// Number of lines held at once per worker thread.
+static const int LINES_PER_WORKER = 8;
+
+/// Size of the transposition table of each worker thread, in megabytes. Kept
+/// small, as it is cleared for every position.
+static const int WORKER_TABLE_SIZE = 4;
+
+/**
+ * Line of input and its result, reused once the result is output.
+ */
+struct BatchSlot {
+  /// Input line, only changed while the slot is not taken by a worker.
+  std::string line;
+
+  /// Output line, valid once `done`.
+  std::string result;
+
+  /// True once the worker analyzing `line` has set `result`.
+  bool done = false;
+};
+
+/**
+ * Lines shared by the reading thread and worker threads. Line `i` of the
+ * input is kept in `slots[i % slots.size()]` until it is output.
+ */
+struct BatchQueue {
+  /// Guards every member.
+  std::mutex mutex;
+
+  /// Notified when a line is read or the input ends.
+  std::condition_variable line_read;
+
+  /// Notified when a result is done.
+  std::condition_variable result_done;
+
+  /// Ring of lines read but not yet output.
+  std::vector<BatchSlot> slots;
+
+  /// Number of lines read, taken by workers and output so far.
+  uint64_t read_count = 0;
+  uint64_t taken_count = 0;
+  uint64_t output_count = 0;
+
+  /// True once every line has been read.
+  bool end_of_input = false;
+
+  /// Counters of every search, added by each worker once it is done.
+  SearchStats stats;
+};
+
+/**
+ * Searches the position of one line.
+ *
+ * @param line FEN or EPD line.
+ * @param table Transposition table of worker, cleared first so the result
+ * does not depend on earlier positions.
+ * @param limits Limits of search, `deadline` is set from `move_time`.
+ * @param move_time Milliseconds the search may use, 0 for no limit.
+ * @param stats Counters of the worker, the search's counters are added.
+ * @return Result line, without newline.
+ */
+static std::string analyze_line(const std::string &line,
+                                TranspositionTable &table,
+                                SearchLimits limits, const int move_time,
+                                SearchStats &stats) {
+  Board board;
+  if (board.set_fen(line) != FenError::NONE &&
+      board.set_fen(epd_position(line)) != FenError::NONE) {
+    return line + ";0000;0;0";
+  }
+
+  table.clear();
+  if (move_time > 0) {
+    limits.deadline = std::chrono::steady_clock::now() +
+                      std::chrono::milliseconds(move_time);
+  }
+  SearchInfo last = SearchInfo();
+  SearchStats search_stats;
+  Move move = find_move(
+      board, board.get_current_move(), table, limits, 1,
+      [&last](const SearchInfo &info) { last = info; }, &search_stats);
+  stats += search_stats;
+
+  // Without a completed iteration the move has no score to report.
+  return board.to_fen() + ";" +
+         (move == Move() ? std::string("0000") : move_to_uci(move)) + ";" +
+         (last.depth == 0 ? std::string("-")
+                          : std::to_string(reported_score(last.score))) +
+         ";" + std::to_string(search_stats.nodes);
+}
+
+/**
+ * Analyzes lines of the queue until every line has been read and taken.
+ *
+ * @param queue Lines shared with the reading thread.
+ * @param limits Limits of each search.
+ * @param move_time Milliseconds each search may use, 0 for no limit.
+ */
+static void batch_worker(BatchQueue &queue, const SearchLimits &limits,
+                         const int move_time) {
+  TranspositionTable table(WORKER_TABLE_SIZE);
+  SearchStats stats;
+  std::unique_lock<std::mutex> lock(queue.mutex);
+  while (true) {
+    queue.line_read.wait(lock, [&queue]() {
+      return queue.taken_count < queue.read_count || queue.end_of_input;
+    });
+    if (queue.taken_count == queue.read_count) {
+      queue.stats += stats;
+      return;
+    }
+
+    // The slot is not reused until its result is output, so it is read
+    // without holding the lock.
+    BatchSlot &slot = queue.slots[queue.taken_count++ % queue.slots.size()];
+    lock.unlock();
+    std::string result =
+        analyze_line(slot.line, table, limits, move_time, stats);
+    lock.lock();
+    slot.result.swap(result);
+    slot.done = true;
+    queue.result_done.notify_one();
+  }
+}
+
+/**
+ * Outputs the results done in input order. Must be called holding the lock
+ * of the queue.
+ *
+ * @param queue Lines shared with worker threads.
+ * @param out Stream to output results to.
+ */
+static void output_results(BatchQueue &queue, std::ostream &out) {
+  while (queue.output_count < queue.read_count) {
+    BatchSlot &slot = queue.slots[queue.output_count % queue.slots.size()];
+    if (!slot.done) {
+      return;
+    }
+    out << slot.result << '\n';
+    slot.done = false;
+    ++queue.output_count;
+  }
+}
+
+void analyze_batch(std::istream &in, std::ostream &out, std::ostream &log,
+                   int workers, int depth, uint64_t nodes, int move_time) {
+  auto start = std::chrono::steady_clock::now();
+  SearchLimits limits;
+  limits.depth = depth;
+  limits.nodes = nodes;
+
+  BatchQueue queue;
+  workers = std::max(1, workers);
+  queue.slots.resize(size_t(workers) * LINES_PER_WORKER);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < workers; ++i) {
+    threads.push_back(std::thread(batch_worker, std::ref(queue),
+                                  std::cref(limits), move_time));
+  }
+
+  // Read one line at a time, waiting for the oldest line to be output while
+  // every slot is taken.
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    queue.result_done.wait(lock, [&queue, &out]() {
+      output_results(queue, out);
+      return queue.read_count - queue.output_count < queue.slots.size();
+    });
+    queue.slots[queue.read_count++ % queue.slots.size()].line.swap(line);
+    lock.unlock();
+    queue.line_read.notify_one();
+  }
+
+  std::unique_lock<std::mutex> lock(queue.mutex);
+  queue.end_of_input = true;
+  queue.line_read.notify_all();
+  queue.result_done.wait(lock, [&queue, &out]() {
+    output_results(queue, out);
+    return queue.output_count == queue.read_count;
+  });
+  lock.unlock();
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  out.flush();
+
+  queue.stats.threads = workers;
+  queue.stats.elapsed = std::chrono::steady_clock::now() - start;
+  double seconds = std::chrono::duration<double>(queue.stats.elapsed).count();
+  log << queue.output_count << " positions in " << seconds << "s, "
+      << queue.output_count / seconds << " positions/s" << std::endl;
+  write_json(log << "stats ", queue.stats) << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <cstdint>
+#include <iostream>
+
+/**
+ * Analyzes a stream of positions, one FEN or EPD line each, on a pool of
+ * worker threads. Each worker searches one position at a time with its own
+ * transposition table, cleared for each position, and the same limits.
+ * Results are output in input order as `fen;bestmove;score;nodes` lines, with
+ * the score in centipawns from the perspective of the color to move, limited
+ * to +/- `MAX_REPORTED_SCORE`, of the last completed iteration, or `-` if no
+ * iteration completed. Nodes count every node searched, including those of
+ * an unfinished iteration. Lines that are not valid positions are output as
+ * `line;0000;0;0`, empty lines and lines starting with '#' are skipped.
+ *
+ * Input is read one line at a time and at most a fixed number of lines per
+ * worker are held at once, so memory use does not grow with input size.
+ *
+ * @param in Stream to read positions from.
+ * @param out Stream to output results to.
+ * @param log Stream to output positions per second and the search statistics
+ * of the whole batch, as JSON, to.
+ * @param workers Number of worker threads.
+ * @param depth Depth limit of last iteration of each search.
+ * @param nodes Number of nodes each search may use, 0 for no limit.
+ * @param move_time Milliseconds each search may use, 0 for no limit.
+ */
+void analyze_batch(std::istream &in, std::ostream &out, std::ostream &log,
+                   int workers, int depth, uint64_t nodes, int move_time);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "bench.h"
+
+#include "board.h"
+#include "search.h"
+#include "transposition.h"
+
+#include <chrono>
+
+/// Positions searched by the benchmark.
+static const char *BENCH_POSITIONS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP2BPPP/R2QKB1R w KQ - 0 8",
+    "2r3k1/pp3ppp/4pn2/3q4/3P4/P4N2/1P3PPP/2RQ2K1 b - - 0 20",
+    "8/5pk1/6p1/3R4/5P2/6KP/r7/8 w - - 0 40"};
+
+void bench(int max_threads, int depth, std::ostream &os) {
+  TranspositionTable table;
+  double single_thread_seconds = 0;
+
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    double seconds = 0;
+    for (const char *fen : BENCH_POSITIONS) {
+      Board board(fen);
+      table.clear();
+      auto start = std::chrono::steady_clock::now();
+      find_move(board, board.get_current_move(), table, depth, threads);
+      seconds += std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+    }
+
+    if (threads == 1) {
+      single_thread_seconds = seconds;
+    }
+    os << "threads " << threads << ": " << seconds << "s, speedup "
+       << single_thread_seconds / seconds << std::endl;
+  }
+}
\ No newline at end of file
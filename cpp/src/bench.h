@@ -0,0 +1,18 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <iostream>
+
+/**
+ * Measures search scaling over threads. Searches a fixed set of positions to
+ * the same depth with 1, 2, 4, ... threads up to `max_threads`, each search
+ * starting from an empty transposition table, and outputs the total time to
+ * depth and speedup over one thread of each thread count.
+ *
+ * @param max_threads Largest number of threads to search with.
+ * @param depth Depth limit of last iteration of each search.
+ * @param os Stream to output results to.
+ */
+void bench(int max_threads, int depth, std::ostream &os);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "bitboard.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+Magic rook_magics[64];
+Magic bishop_magics[64];
+bool use_pext = false;
+Bitboard between_table[64][64];
+Bitboard line_table[64][64];
+
+/// Attack table storage shared by all squares of each slider.
+static Bitboard rook_table[0x19000];
+static Bitboard bishop_table[0x1480];
+
+/// Precomputed multipliers, each giving a collision-free index for its square.
+static const Bitboard ROOK_MAGIC_NUMBERS[64] = {
+    0x1080004008801020ULL, 0x0840092002c03000ULL, 0x1900200010400900ULL,
+    0x0880100008000480ULL, 0x4200100420080200ULL, 0x8100020100080400ULL,
+    0x0200040110886200ULL, 0x0200008040220411ULL, 0x0404800084400220ULL,
+    0x0000401000402000ULL, 0x0086001081220440ULL, 0x0408800800100280ULL,
+    0x000a001201040820ULL, 0x8848800200840080ULL, 0x4001000100040200ULL,
+    0x0442000102105084ULL, 0x9080010020804100ULL, 0x0040404000201009ULL,
+    0x0000808010002009ULL, 0x2200090021d00100ULL, 0x0008008008040080ULL,
+    0x0004004002010040ULL, 0x0011040008015042ULL, 0x00000a0001768104ULL,
+    0x0000800080204009ULL, 0x2010004140002001ULL, 0x9800200280100080ULL,
+    0x1000100080080080ULL, 0x0442000a00049020ULL, 0x2100040080020080ULL,
+    0x0800120400900148ULL, 0x0010040a00128541ULL, 0x2800804000800030ULL,
+    0x1010002000400041ULL, 0x4000200011004100ULL, 0x0610008410800800ULL,
+    0x0400802402800800ULL, 0xc100020080800400ULL, 0x0002000802000401ULL,
+    0x0182085882000401ULL, 0x0220204000808000ULL, 0x2860100040024022ULL,
+    0x0001002004110040ULL, 0x99101042000a0020ULL, 0x0004080004008080ULL,
+    0x0010040002008080ULL, 0x2012004881020004ULL, 0x8300842444820011ULL,
+    0x0088403882010200ULL, 0x0820400080210100ULL, 0x0110910040a00300ULL,
+    0x0801100280080480ULL, 0x0242009008200600ULL, 0x1002000489500200ULL,
+    0x0040800200010080ULL, 0x0091800041000080ULL, 0x0000209300488001ULL,
+    0x04c1002414824001ULL, 0x020020000b001041ULL, 0x7000100004200901ULL,
+    0x8002002004100802ULL, 0x30010002084c0007ULL, 0x0888221800813004ULL,
+    0x4000002840840112ULL};
+
+static const Bitboard BISHOP_MAGIC_NUMBERS[64] = {
+    0xa010041108003100ULL, 0x006082020a002900ULL, 0x6810010619200000ULL,
+    0x08281a0520000408ULL, 0x0001104001000400ULL, 0x0018901008048400ULL,
+    0x00040a0210245280ULL, 0x000200210808a402ULL, 0x9140048410821200ULL,
+    0x0800091010820041ULL, 0x20504804832202c0ULL, 0x0100091401081000ULL,
+    0x8021011140000012ULL, 0x0810020804450400ULL, 0x208b0542109008a2ULL,
+    0x0080084a08040204ULL, 0x0040e2a80811244cULL, 0x2505022008008108ULL,
+    0x0430220100420040ULL, 0x010a040420220040ULL, 0x1105000290400000ULL,
+    0x0093001200822120ULL, 0x4000a62048043004ULL, 0x280120048a015004ULL,
+    0x006090002a020814ULL, 0x44042000240800d0ULL, 0x01102800040a4400ULL,
+    0x1004080080220040ULL, 0x0001001011004024ULL, 0x0010044000805040ULL,
+    0x0914041200820100ULL, 0x0004821012821480ULL, 0x0024040500c05021ULL,
+    0x0088611002080200ULL, 0x0116080a00040020ULL, 0x4000020080080080ULL,
+    0x2450450140840040ULL, 0x0000880201484100ULL, 0x0222020404020092ULL,
+    0x8081110600002e00ULL, 0x2842101105000801ULL, 0x1100809008001025ULL,
+    0x00020202221c0400ULL, 0x0422014022009020ULL, 0x0210046102100c00ULL,
+    0xc004008082029102ULL, 0x00aa461801101200ULL, 0x0404080080201108ULL,
+    0x020542108c205002ULL, 0x0410544804100100ULL, 0x0040910841100000ULL,
+    0x0400200042021100ULL, 0x00004204850400c0ULL, 0x0200100410a42102ULL,
+    0x1040020801210102ULL, 0x0805040410420000ULL, 0x2884804130100200ULL,
+    0x800c262201242000ULL, 0x1058000194108800ULL, 0x0014221054420204ULL,
+    0x0104000012a02200ULL, 0x0200881003300100ULL, 0x0140400202840100ULL,
+    0x0402020801010201ULL};
+
+/// Squares from each square to the board edge along each direction.
+static Bitboard rays[8][64];
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("bmi2"))) Bitboard pext(const Bitboard value,
+                                              const Bitboard mask) {
+  return _pext_u64(value, mask);
+}
+#else
+Bitboard pext(const Bitboard value, const Bitboard mask) {
+  // Portable fallback, never selected by `init_bitboards`.
+  Bitboard result = 0;
+  int bit = 0;
+  for (Bitboard remaining = mask; remaining; remaining &= remaining - 1) {
+    if (value & remaining & -remaining) {
+      result |= Bitboard(1) << bit;
+    }
+    ++bit;
+  }
+  return result;
+}
+#endif
+
+/**
+ * Computes the squares attacked along one ray, cutting the ray at its first
+ * blocker.
+ *
+ * @param dir Ray direction.
+ * @param square Square index of slider.
+ * @param occupied Bitboard of occupied squares.
+ * @return Bitboard of attacked squares along the ray.
+ */
+static inline Bitboard ray_attacks(const int dir, const int square,
+                                   const Bitboard occupied) {
+  Bitboard ray = rays[dir][square];
+
+  // Rays past a1 or h8 are empty, so they act as a blocker on every ray
+  // without a branch on whether the ray is blocked.
+  if (dir < 4) {
+    return ray ^ rays[dir][lsb((ray & occupied) | square_bb(63))];
+  }
+  return ray ^ rays[dir][msb((ray & occupied) | square_bb(0))];
+}
+
+/**
+ * Computes the squares attacked along both rays of a line, cutting each ray
+ * at its first blocker. Only used to fill attack tables.
+ *
+ * @param dir Direction of one ray of the line, below 4.
+ * @param square Square index of slider.
+ * @param occupied Bitboard of occupied squares.
+ * @return Bitboard of attacked squares along the line.
+ */
+static Bitboard line_attacks(const int dir, const int square,
+                             const Bitboard occupied) {
+  return ray_attacks(dir, square, occupied) |
+         ray_attacks(dir ^ 4, square, occupied);
+}
+
+/**
+ * Fills the magic lookups and attack table of one slider type.
+ *
+ * @param magics Magic lookup of each square to fill.
+ * @param table Attack table storage.
+ * @param magic_numbers Precomputed multiplier of each square.
+ * @param bishop Boolean if filling bishop tables instead of rook tables.
+ */
+static void init_magics(Magic magics[64], Bitboard *table,
+                        const Bitboard magic_numbers[64], const bool bishop) {
+  // A slider moves along two lines, ranks and files or both diagonals, of
+  // directions `first_dir` and `first_dir + 1`.
+  const int first_dir = bishop ? 2 : 0;
+  Bitboard *attacks = table;
+  for (int square = 0; square < 64; ++square) {
+    // Board edges do not block, exclude them unless on the slider's own line.
+    Bitboard edges = ((RANK_1 | RANK_8) & ~(RANK_1 << (square & ~7))) |
+                     ((FILE_A | FILE_H) & ~(FILE_A << (square & 7)));
+
+    Magic &magic = magics[square];
+    magic.mask = (line_attacks(first_dir, square, 0) |
+                  line_attacks(first_dir + 1, square, 0)) &
+                 ~edges;
+    magic.magic = magic_numbers[square];
+    magic.shift = 64 - popcount(magic.mask);
+    magic.attacks = attacks;
+
+    // Blockers on one line do not change attacks along the other, so the
+    // attacks of every subset of each line's mask (Carry-Rippler) are found
+    // once, and each table entry is the union of one subset of each line.
+    Bitboard subsets[2][64], subset_attacks[2][64];
+    int subset_count[2] = {0, 0};
+    for (int line = 0; line < 2; ++line) {
+      int dir = first_dir + line;
+      Bitboard line_mask = line_attacks(dir, square, 0) & magic.mask;
+      Bitboard occupied = 0;
+      do {
+        subsets[line][subset_count[line]] = occupied;
+        subset_attacks[line][subset_count[line]++] =
+            line_attacks(dir, square, occupied);
+        occupied = (occupied - line_mask) & line_mask;
+      } while (occupied);
+    }
+    for (int i = 0; i < subset_count[0]; ++i) {
+      for (int j = 0; j < subset_count[1]; ++j) {
+        magic.attacks[magic.index(subsets[0][i] | subsets[1][j])] =
+            subset_attacks[0][i] | subset_attacks[1][j];
+      }
+    }
+
+    attacks += 1 << (64 - magic.shift);
+  }
+}
+
+void init_bitboards() {
+#if defined(__x86_64__) || defined(__i386__)
+  use_pext = __builtin_cpu_supports("bmi2");
+#endif
+
+  // Walk each ray once, slider attacks are then built from whole rays.
+  for (int dir = 0; dir < 8; ++dir) {
+    for (int square = 0; square < 64; ++square) {
+      rays[dir][square] = 0;
+      int rank = (square >> 3) + DIRECTIONS[dir][0];
+      int file = (square & 7) + DIRECTIONS[dir][1];
+      for (; rank >= 0 && rank < 8 && file >= 0 && file < 8;
+           rank += DIRECTIONS[dir][0], file += DIRECTIONS[dir][1]) {
+        rays[dir][square] |= square_bb(rank * 8 + file);
+      }
+    }
+  }
+
+  // Lines and squares between aligned squares, the opposite of direction
+  // `dir` is `dir ^ 4`.
+  for (int square = 0; square < 64; ++square) {
+    for (int dir = 0; dir < 8; ++dir) {
+      Bitboard full_line =
+          rays[dir][square] | rays[dir ^ 4][square] | square_bb(square);
+      Bitboard ray = rays[dir][square];
+      while (ray) {
+        int target = pop_lsb(ray);
+        between_table[square][target] =
+            rays[dir][square] & ~rays[dir][target] & ~square_bb(target);
+        line_table[square][target] = full_line;
+      }
+    }
+  }
+
+  init_magics(rook_magics, rook_table, ROOK_MAGIC_NUMBERS, false);
+  init_magics(bishop_magics, bishop_table, BISHOP_MAGIC_NUMBERS, true);
+}
\ No newline at end of file
@@ -0,0 +1,292 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "coordinate.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// Set of board squares, one bit per square (a1 = bit 0, h8 = bit 63).
+typedef uint64_t Bitboard;
+
+/// Bitboards of the edge files and ranks.
+const Bitboard FILE_A = 0x0101010101010101;
+const Bitboard FILE_H = FILE_A << 7;
+const Bitboard RANK_1 = 0xFF;
+const Bitboard RANK_8 = RANK_1 << 56;
+
+/**
+ * Converts a coordinate into a square index.
+ *
+ * @param coordinate Coordinate within the board.
+ * @return Square index of `coordinate` (rank * 8 + file).
+ */
+inline int to_square(const Coordinate &coordinate) {
+  return coordinate.get_rank() * 8 + coordinate.get_file();
+}
+
+/**
+ * Converts a square index into a coordinate.
+ *
+ * @param square Square index.
+ * @return Coordinate of `square`.
+ */
+inline Coordinate to_coordinate(const int square) {
+  return Coordinate(square >> 3, square & 7);
+}
+
+/**
+ * Constructs a bitboard with a single square set.
+ *
+ * @param square Square index.
+ * @return Bitboard containing only `square`.
+ */
+constexpr Bitboard square_bb(const int square) { return Bitboard(1) << square; }
+
+/**
+ * Finds the lowest set square of a non-empty bitboard.
+ *
+ * @param bitboard Non-empty bitboard.
+ * @return Square index of least significant set bit.
+ */
+inline int lsb(const Bitboard bitboard) { return __builtin_ctzll(bitboard); }
+
+/**
+ * Finds the highest set square of a non-empty bitboard.
+ *
+ * @param bitboard Non-empty bitboard.
+ * @return Square index of most significant set bit.
+ */
+inline int msb(const Bitboard bitboard) {
+  return 63 - __builtin_clzll(bitboard);
+}
+
+/**
+ * Removes and returns the lowest set square of a non-empty bitboard.
+ *
+ * @param bitboard Non-empty bitboard to pop from.
+ * @return Square index of the popped bit.
+ */
+inline int pop_lsb(Bitboard &bitboard) {
+  int square = lsb(bitboard);
+  bitboard &= bitboard - 1;
+  return square;
+}
+
+/**
+ * Counts the number of set squares in a bitboard.
+ *
+ * @param bitboard Bitboard to count.
+ * @return Number of set bits.
+ */
+inline int popcount(const Bitboard bitboard) {
+  return __builtin_popcountll(bitboard);
+}
+
+/**
+ * Sliding attack lookup for a single square. The relevant occupancy of a
+ * square is mapped to an index into its slice of the attack table, with a
+ * multiply-shift magic or with PEXT on CPUs supporting BMI2.
+ */
+struct Magic {
+  /// Squares whose occupancy can block the slider, board edges excluded.
+  Bitboard mask;
+
+  /// Multiplier mapping each subset of `mask` to a unique index.
+  Bitboard magic;
+
+  /// Attack sets of this square, indexed by `index`.
+  Bitboard *attacks;
+
+  /// Shift applied to the product of `magic`, 64 - popcount(`mask`).
+  unsigned shift;
+
+  /**
+   * Computes the attack table index of an occupancy.
+   *
+   * @param occupied Bitboard of occupied squares.
+   * @return Index into `attacks`.
+   */
+  unsigned index(const Bitboard occupied) const;
+};
+
+/// Rook magic lookup of each square.
+extern Magic rook_magics[64];
+
+/// Bishop magic lookup of each square.
+extern Magic bishop_magics[64];
+
+/// True if attack tables are indexed with PEXT instead of magic multiply.
+extern bool use_pext;
+
+/// Rank and file steps of knight moves (counterclockwise).
+constexpr int KNIGHT_STEPS[8][2] = {{2, 1},   {1, 2},   {-1, 2}, {-2, 1},
+                                    {-2, -1}, {-1, -2}, {1, -2}, {2, -1}};
+
+/// Rank and file steps of each ray direction, also the king moves. Directions
+/// 0-3 step towards higher square indices, 4-7 towards lower.
+constexpr int DIRECTIONS[8][2] = {{1, 0},  {0, 1},  {1, 1},   {1, -1},
+                                  {-1, 0}, {0, -1}, {-1, -1}, {-1, 1}};
+
+/// Rank and file steps of pawn captures, indexed by color (white forward).
+constexpr int PAWN_STEPS[2][2][2] = {{{1, -1}, {1, 1}}, {{-1, -1}, {-1, 1}}};
+
+/**
+ * Builds the attack table of a piece moving by single steps (leaper), each
+ * entry holding the on-board destinations from one square.
+ *
+ * @param steps Rank and file offsets of each step.
+ * @return Attack bitboard of each square.
+ */
+template <std::size_t N>
+constexpr std::array<Bitboard, 64> step_attack_table(const int (&steps)[N][2]) {
+  std::array<Bitboard, 64> table{};
+  for (int square = 0; square < 64; ++square) {
+    for (std::size_t i = 0; i < N; ++i) {
+      int rank = (square >> 3) + steps[i][0], file = (square & 7) + steps[i][1];
+      if (rank >= 0 && rank < 8 && file >= 0 && file < 8) {
+        table[square] |= square_bb(rank * 8 + file);
+      }
+    }
+  }
+  return table;
+}
+
+/// Knight attacks from each square, built at compile time.
+inline constexpr std::array<Bitboard, 64> knight_attack_table =
+    step_attack_table(KNIGHT_STEPS);
+
+/// King attacks from each square, built at compile time.
+inline constexpr std::array<Bitboard, 64> king_attack_table =
+    step_attack_table(DIRECTIONS);
+
+/// Pawn capture attacks from each square, indexed by color then square, built
+/// at compile time.
+inline constexpr std::array<Bitboard, 64> pawn_attack_table[2] = {
+    step_attack_table(PAWN_STEPS[0]), step_attack_table(PAWN_STEPS[1])};
+
+/// Squares strictly between two squares on a shared rank, file or diagonal,
+/// indexed by both squares. Empty if the squares are not aligned.
+extern Bitboard between_table[64][64];
+
+/// Full rank, file or diagonal through two aligned squares, indexed by both
+/// squares. Empty if the squares are not aligned.
+extern Bitboard line_table[64][64];
+
+/**
+ * Extracts the bits of a value selected by a mask into the low bits, using
+ * the BMI2 PEXT instruction. Only called when `use_pext` is set.
+ *
+ * @param value Value to extract bits from.
+ * @param mask Bits to extract.
+ * @return Extracted bits packed into the low bits.
+ */
+Bitboard pext(const Bitboard value, const Bitboard mask);
+
+inline unsigned Magic::index(const Bitboard occupied) const {
+  if (use_pext) {
+    return unsigned(pext(occupied, mask));
+  }
+  return unsigned(((occupied & mask) * magic) >> shift);
+}
+
+/**
+ * Builds the attack tables. Must be called once at startup before any board
+ * is used.
+ */
+void init_bitboards();
+
+/**
+ * Obtains the squares attacked by a knight.
+ *
+ * @param square Square index of knight.
+ * @return Bitboard of squares attacked from `square`.
+ */
+inline Bitboard knight_attacks(const int square) {
+  return knight_attack_table[square];
+}
+
+/**
+ * Obtains the squares attacked by a king.
+ *
+ * @param square Square index of king.
+ * @return Bitboard of squares attacked from `square`.
+ */
+inline Bitboard king_attacks(const int square) {
+  return king_attack_table[square];
+}
+
+/**
+ * Obtains the squares attacked by a pawn.
+ *
+ * @param color Color index of pawn (0 for white, 1 for black).
+ * @param square Square index of pawn.
+ * @return Bitboard of squares the pawn captures on from `square`.
+ */
+inline Bitboard pawn_attacks(const int color, const int square) {
+  return pawn_attack_table[color][square];
+}
+
+/**
+ * Obtains the squares between two squares.
+ *
+ * @param from Square index of one end.
+ * @param to Square index of other end.
+ * @return Bitboard of squares strictly between `from` and `to` if aligned,
+ * otherwise empty.
+ */
+inline Bitboard between(const int from, const int to) {
+  return between_table[from][to];
+}
+
+/**
+ * Obtains the line through two squares.
+ *
+ * @param from Square index on line.
+ * @param to Other square index on line.
+ * @return Bitboard of the whole rank, file or diagonal through `from` and
+ * `to` if aligned, otherwise empty.
+ */
+inline Bitboard line(const int from, const int to) {
+  return line_table[from][to];
+}
+
+/**
+ * Obtains the squares attacked by a rook.
+ *
+ * @param square Square index of rook.
+ * @param occupied Bitboard of occupied squares.
+ * @return Bitboard of squares attacked from `square`, up to and including the
+ * first blocker in each direction.
+ */
+inline Bitboard rook_attacks(const int square, const Bitboard occupied) {
+  const Magic &magic = rook_magics[square];
+  return magic.attacks[magic.index(occupied)];
+}
+
+/**
+ * Obtains the squares attacked by a bishop.
+ *
+ * @param square Square index of bishop.
+ * @param occupied Bitboard of occupied squares.
+ * @return Bitboard of squares attacked from `square`, up to and including the
+ * first blocker in each direction.
+ */
+inline Bitboard bishop_attacks(const int square, const Bitboard occupied) {
+  const Magic &magic = bishop_magics[square];
+  return magic.attacks[magic.index(occupied)];
+}
+
+/**
+ * Obtains the squares attacked by a queen.
+ *
+ * @param square Square index of queen.
+ * @param occupied Bitboard of occupied squares.
+ * @return Bitboard of squares attacked from `square`.
+ */
+inline Bitboard queen_attacks(const int square, const Bitboard occupied) {
+  return rook_attacks(square, occupied) | bishop_attacks(square, occupied);
+}
+
+#endif
\ No newline at end of file
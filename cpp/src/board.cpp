@@ -7,133 +7,401 @@
 #include "piece/queen.h"
 #include "piece/rook.h"
 
+#include "evaluation.h"
 #include "util.h"
+#include "zobrist.h"
 #include <bits/stdc++.h>
 
-Board::Board() {
-  constructor("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+/**
+ * Determines if a move promotes a pawn.
+ *
+ * @param move Move to check.
+ * @return Boolean value if `move` is a promotion.
+ */
+static bool is_promotion(const Move &move) {
+  return move.get_type() == Move::MoveType::KNIGHT_PROMOTION ||
+         move.get_type() == Move::MoveType::BISHOP_PROMOTION ||
+         move.get_type() == Move::MoveType::ROOK_PROMOTION ||
+         move.get_type() == Move::MoveType::QUEEN_PROMOTION;
 }
 
-Board::Board(const std::string fen_string) { constructor(fen_string); }
+/**
+ * Value of a piece type for static exchange evaluation. The king outweighs
+ * any material it could win, so capturing into a defended square with it is
+ * never favorable.
+ *
+ * @param type Type of piece.
+ * @return Value of `type` in centipawns.
+ */
+static int see_value(const Piece::Type type) {
+  return type == Piece::Type::KING ? 20000 : PIECE_VALUES[int(type)];
+}
 
-void Board::constructor(const std::string fen_string) {
-  // Build 2-D array of piece pointers.
-  m_board = new Piece **[SIZE];
-  for (int rank = 0; rank < SIZE; ++rank) {
-    m_board[rank] = new Piece *[SIZE];
-    for (int file = 0; file < SIZE; ++file) {
-      m_board[rank][file] = nullptr;
+/**
+ * Castling rights kept when a piece moves from or to a square.
+ *
+ * @param square Square index.
+ * @return Mask of castling rights unaffected by `square`.
+ */
+static int castling_mask(const int square) {
+  switch (square) {
+  case 0:
+    return ~Board::WHITE_QUEEN_CASTLE;
+  case 4:
+    return ~(Board::WHITE_KING_CASTLE | Board::WHITE_QUEEN_CASTLE);
+  case 7:
+    return ~Board::WHITE_KING_CASTLE;
+  case 56:
+    return ~Board::BLACK_QUEEN_CASTLE;
+  case 60:
+    return ~(Board::BLACK_KING_CASTLE | Board::BLACK_QUEEN_CASTLE);
+  case 63:
+    return ~Board::BLACK_KING_CASTLE;
+  default:
+    return ~0;
+  }
+}
+
+/// FEN letters of pieces indexed by type, white pieces in upper case.
+static const char WHITE_PIECE_CHARS[] = "PNBRQK";
+static const char BLACK_PIECE_CHARS[] = "pnbrqk";
+
+/**
+ * Reads the piece of a FEN letter.
+ *
+ * @param letter FEN letter.
+ * @param type Set to type of piece.
+ * @param color Set to color of piece.
+ * @return Boolean value if `letter` is a piece letter.
+ */
+static bool parse_piece(const char letter, Piece::Type &type,
+                        Piece::Color &color) {
+  for (int i = 0; i < 6; ++i) {
+    if (letter == WHITE_PIECE_CHARS[i] || letter == BLACK_PIECE_CHARS[i]) {
+      type = Piece::Type(i);
+      color = letter == WHITE_PIECE_CHARS[i] ? Piece::Color::WHITE
+                                              : Piece::Color::BLACK;
+      return true;
     }
   }
+  return false;
+}
 
-  std::string piece_locations = fen_string.substr(0, fen_string.find(' '));
-  std::string info = fen_string.substr(piece_locations.length() + 1);
+/**
+ * Moves past the spaces before the next field of a FEN string.
+ *
+ * @param fen FEN string.
+ * @param i Index of end of current field, set to start of next field.
+ * @return Boolean value if a field follows.
+ */
+static bool next_field(const std::string_view fen, size_t &i) {
+  size_t start = i;
+  while (i < fen.size() && fen[i] == ' ') {
+    ++i;
+  }
+  return i > start && i < fen.size();
+}
 
-  m_current_move = (info[0] == 'w') ? Piece::Color::WHITE : Piece::Color::BLACK;
-  m_draw_counter = 0;
+/**
+ * Determines if a field of a FEN string ends at an index.
+ *
+ * @param fen FEN string.
+ * @param i Index after last character of field.
+ * @return Boolean value if `i` is at a space or the end of `fen`.
+ */
+static bool field_ends(const std::string_view fen, const size_t i) {
+  return i >= fen.size() || fen[i] == ' ';
+}
 
-  info = info.substr(info.find(' ') + 1);
-  std::string rook_info = info.substr(0, info.find(' '));
+/**
+ * Reads a non-negative number field of a FEN string.
+ *
+ * @param fen FEN string.
+ * @param i Index of start of number, set to the index after it.
+ * @param number Set to number read.
+ * @return Boolean value if a number of at most 9 digits was read.
+ */
+static bool parse_number(const std::string_view fen, size_t &i, int &number) {
+  size_t start = i;
+  number = 0;
+  for (; i < fen.size() && fen[i] >= '0' && fen[i] <= '9'; ++i) {
+    if (i - start == 9) {
+      return false;
+    }
+    number = number * 10 + (fen[i] - '0');
+  }
+  return i > start;
+}
 
-  // Create every piece object that exists on board according to the fen_string.
-  std::string board_row;
-  for (int rank = SIZE - 1; rank >= 0; --rank) {
-    board_row = piece_locations.substr(0, piece_locations.find('/'));
-    piece_locations = piece_locations.substr(piece_locations.find('/') + 1);
-    for (int file = 0, str_file = 0; file < SIZE; ++file, ++str_file) {
-      switch (board_row[str_file]) {
-      // Black pawns
-      case 'p':
-        m_board[rank][file] =
-            new Pawn(this, Piece::Color::BLACK, Coordinate(rank, file),
-                     !(rank == SIZE - 2));
-        break;
+static_assert(sizeof(Pawn) == sizeof(Piece) &&
+                  sizeof(Knight) == sizeof(Piece) &&
+                  sizeof(Bishop) == sizeof(Piece) &&
+                  sizeof(Rook) == sizeof(Piece) &&
+                  sizeof(Queen) == sizeof(Piece) &&
+                  sizeof(King) == sizeof(Piece),
+              "Every piece type must fit a piece pool slot");
 
-      // Black knights
-      case 'n':
-        m_board[rank][file] =
-            new Knight(this, Piece::Color::BLACK, Coordinate(rank, file));
-        break;
+/**
+ * Constructs a piece object of any type in preallocated storage.
+ *
+ * @param slot Storage of at least `sizeof(Piece)` bytes.
+ * @param board Pointer to board object which the piece resides on.
+ * @param type Type of piece.
+ * @param color Color of piece.
+ * @param coordinate Location of piece on board.
+ * @param moved Boolean if piece has moved on board.
+ * @return Pointer to constructed piece.
+ */
+static Piece *construct_piece(void *slot, Board *board, const Piece::Type type,
+                              const Piece::Color color,
+                              const Coordinate &coordinate, const bool moved) {
+  switch (type) {
+  case Piece::Type::PAWN:
+    return new (slot) Pawn(board, color, coordinate, moved);
+  case Piece::Type::KNIGHT:
+    return new (slot) Knight(board, color, coordinate, moved);
+  case Piece::Type::BISHOP:
+    return new (slot) Bishop(board, color, coordinate, moved);
+  case Piece::Type::ROOK:
+    return new (slot) Rook(board, color, coordinate, moved);
+  case Piece::Type::QUEEN:
+    return new (slot) Queen(board, color, coordinate, moved);
+  default:
+    return new (slot) King(board, color, coordinate, moved);
+  }
+}
 
-      // Black bishops
-      case 'b':
-        m_board[rank][file] =
-            new Bishop(this, Piece::Color::BLACK, Coordinate(rank, file));
-        break;
+Board::Board() : m_piece_count(0) { set_fen(START_FEN); }
 
-      // Black rooks
-      case 'r':
-        m_board[rank][file] =
-            new Rook(this, Piece::Color::BLACK, Coordinate(rank, file),
-                     !((rook_info.find('q') != std::string::npos && rank == 7 &&
-                        file == 0) ||
-                       (rook_info.find('k') != std::string::npos && rank == 7 &&
-                        file == 7)));
-        break;
+Board::Board(const std::string_view fen) : m_piece_count(0) {
+  if (set_fen(fen) != FenError::NONE) {
+    set_fen(EMPTY_FEN);
+  }
+}
 
-      // Black queen
-      case 'q':
-        m_board[rank][file] =
-            new Queen(this, Piece::Color::BLACK, Coordinate(rank, file));
-        break;
+FenError Board::set_fen(const std::string_view fen) {
+  // Read every field before changing the board. Piece letter of each square,
+  // 0 if empty.
+  char placement[SIZE * SIZE] = {};
+  int piece_count = 0;
+  size_t i = 0;
+  int rank = SIZE - 1, file = 0;
+  for (; i < fen.size() && fen[i] != ' '; ++i) {
+    Piece::Type type;
+    Piece::Color color;
+    if (fen[i] == '/') {
+      if (file != SIZE || rank == 0) {
+        return FenError::PIECE_PLACEMENT;
+      }
+      --rank;
+      file = 0;
+    } else if (fen[i] >= '1' && fen[i] <= '8') {
+      file += fen[i] - '0';
+      if (file > SIZE) {
+        return FenError::PIECE_PLACEMENT;
+      }
+    } else if (file == SIZE || !parse_piece(fen[i], type, color) ||
+               (type == Piece::Type::PAWN &&
+                (rank == 0 || rank == SIZE - 1))) {
+      return FenError::PIECE_PLACEMENT;
+    } else if (++piece_count > MAX_PIECES) {
+      return FenError::TOO_MANY_PIECES;
+    } else {
+      placement[rank * SIZE + file++] = fen[i];
+    }
+  }
+  if (rank != 0 || file != SIZE) {
+    return FenError::PIECE_PLACEMENT;
+  }
 
-      // Black king
+  if (!next_field(fen, i) || (fen[i] != 'w' && fen[i] != 'b') ||
+      !field_ends(fen, i + 1)) {
+    return FenError::SIDE_TO_MOVE;
+  }
+  Piece::Color current_move =
+      fen[i++] == 'w' ? Piece::Color::WHITE : Piece::Color::BLACK;
+
+  if (!next_field(fen, i)) {
+    return FenError::CASTLING_RIGHTS;
+  }
+  int castling_rights = 0;
+  if (fen[i] == '-') {
+    ++i;
+  } else {
+    for (; !field_ends(fen, i); ++i) {
+      switch (fen[i]) {
+      case 'K':
+        castling_rights |= WHITE_KING_CASTLE;
+        break;
+      case 'Q':
+        castling_rights |= WHITE_QUEEN_CASTLE;
+        break;
       case 'k':
-        m_board[rank][file] =
-            new King(this, Piece::Color::BLACK, Coordinate(rank, file),
-                     !(rook_info.find('q') != std::string::npos ||
-                       rook_info.find('k') != std::string::npos));
+        castling_rights |= BLACK_KING_CASTLE;
         break;
-
-      // White pawns
-      case 'P':
-        m_board[rank][file] = new Pawn(this, Piece::Color::WHITE,
-                                       Coordinate(rank, file), !(rank == 1));
+      case 'q':
+        castling_rights |= BLACK_QUEEN_CASTLE;
         break;
+      default:
+        return FenError::CASTLING_RIGHTS;
+      }
+    }
+  }
+  if (!field_ends(fen, i)) {
+    return FenError::CASTLING_RIGHTS;
+  }
 
-      // White knights
-      case 'N':
-        m_board[rank][file] =
-            new Knight(this, Piece::Color::WHITE, Coordinate(rank, file));
-        break;
+  // A right needs its king and rook on their starting squares.
+  if (placement[4] != 'K') {
+    castling_rights &= ~(WHITE_KING_CASTLE | WHITE_QUEEN_CASTLE);
+  }
+  if (placement[7] != 'R') {
+    castling_rights &= ~WHITE_KING_CASTLE;
+  }
+  if (placement[0] != 'R') {
+    castling_rights &= ~WHITE_QUEEN_CASTLE;
+  }
+  if (placement[60] != 'k') {
+    castling_rights &= ~(BLACK_KING_CASTLE | BLACK_QUEEN_CASTLE);
+  }
+  if (placement[63] != 'r') {
+    castling_rights &= ~BLACK_KING_CASTLE;
+  }
+  if (placement[56] != 'r') {
+    castling_rights &= ~BLACK_QUEEN_CASTLE;
+  }
 
-      // White bishops
-      case 'B':
-        m_board[rank][file] =
-            new Bishop(this, Piece::Color::WHITE, Coordinate(rank, file));
-        break;
+  // The em passant target is behind the pawn that just moved, on the sixth
+  // rank if white is to move and on the third otherwise. The target and the
+  // square the pawn came from are empty.
+  if (!next_field(fen, i)) {
+    return FenError::EM_PASSANT_TARGET;
+  }
+  Coordinate empassant_target(-1, -1);
+  if (fen[i] == '-') {
+    ++i;
+  } else {
+    int target_rank = current_move == Piece::Color::WHITE ? 5 : 2;
+    if (i + 1 >= fen.size() || fen[i] < 'a' || fen[i] > 'h' ||
+        fen[i + 1] - '1' != target_rank) {
+      return FenError::EM_PASSANT_TARGET;
+    }
+    int target = target_rank * SIZE + fen[i] - 'a';
+    int forward = current_move == Piece::Color::WHITE ? SIZE : -SIZE;
+    char pawn = current_move == Piece::Color::WHITE ? 'p' : 'P';
+    if (placement[target] != 0 || placement[target + forward] != 0 ||
+        placement[target - forward] != pawn) {
+      return FenError::EM_PASSANT_TARGET;
+    }
+    empassant_target = Coordinate(target_rank, fen[i] - 'a');
+    i += 2;
+  }
+  if (!field_ends(fen, i)) {
+    return FenError::EM_PASSANT_TARGET;
+  }
 
-      // White rooks
-      case 'R':
-        m_board[rank][file] =
-            new Rook(this, Piece::Color::WHITE, Coordinate(rank, file),
-                     !((rook_info.find('Q') != std::string::npos && rank == 0 &&
-                        file == 0) ||
-                       (rook_info.find('K') != std::string::npos && rank == 0 &&
-                        file == 7)));
-        break;
+  int halfmove_clock = 0, fullmove_number = 1;
+  if (next_field(fen, i)) {
+    if (!parse_number(fen, i, halfmove_clock) || !field_ends(fen, i)) {
+      return FenError::HALFMOVE_CLOCK;
+    }
+    if (!next_field(fen, i) || !parse_number(fen, i, fullmove_number) ||
+        fullmove_number < 1 || next_field(fen, i) || i != fen.size()) {
+      return FenError::FULLMOVE_NUMBER;
+    }
+  }
 
-      // White queen
-      case 'Q':
-        m_board[rank][file] =
-            new Queen(this, Piece::Color::WHITE, Coordinate(rank, file));
-        break;
+  // Start from an empty board.
+  destroy();
+  m_key_history.clear();
+  for (int color = 0; color < 2; ++color) {
+    for (int type = 0; type < 6; ++type) {
+      m_pieces[color][type] = 0;
+    }
+    m_occupancy[color] = 0;
+  }
+  for (int square = 0; square < SIZE * SIZE; ++square) {
+    m_squares[square] = nullptr;
+  }
+  m_score_mg = 0;
+  m_score_eg = 0;
+  m_phase = 0;
+  m_key = 0;
 
-      // White king
-      case 'K':
-        m_board[rank][file] =
-            new King(this, Piece::Color::WHITE, Coordinate(rank, file),
-                     !(rook_info.find('Q') != std::string::npos ||
-                       rook_info.find('K') != std::string::npos));
-        break;
+  m_current_move = current_move;
+  m_castling_rights = castling_rights;
+  m_empassant_target = empassant_target;
+  m_draw_counter = halfmove_clock;
+  m_fullmove_number = fullmove_number;
 
-      // Increment board_file to skip files if number in fen_string row.
-      default:
-        file += board_row[str_file] - '0' - 1;
+  // Create every piece object of the layout. Pawns on their starting rank
+  // have not moved, nor have kings and rooks still able to castle.
+  for (int square = 0; square < SIZE * SIZE; ++square) {
+    Piece::Type type;
+    Piece::Color color;
+    if (!placement[square] || !parse_piece(placement[square], type, color)) {
+      continue;
+    }
+    bool moved = false;
+    if (type == Piece::Type::PAWN) {
+      moved = square / SIZE != (color == Piece::Color::WHITE ? 1 : SIZE - 2);
+    } else if (type == Piece::Type::KING || type == Piece::Type::ROOK) {
+      moved = !(castling_rights & ~castling_mask(square));
+    }
+    put_piece(new_piece(type, color, to_coordinate(square), moved));
+  }
+
+  m_key = compute_key();
+  return FenError::NONE;
+}
+
+std::string Board::to_fen() const {
+  // Longest FEN is 64 squares and 7 separators, then the other fields.
+  char fen[128];
+  size_t length = 0;
+  for (int rank = SIZE - 1; rank >= 0; --rank) {
+    int empty = 0;
+    for (int file = 0; file < SIZE; ++file) {
+      const Piece *piece = m_squares[rank * SIZE + file];
+      if (piece == nullptr) {
+        ++empty;
         continue;
       }
+      if (empty) {
+        fen[length++] = char('0' + empty);
+        empty = 0;
+      }
+      fen[length++] = (piece->get_color() == Piece::Color::WHITE
+                           ? WHITE_PIECE_CHARS
+                           : BLACK_PIECE_CHARS)[int(piece->get_type())];
+    }
+    if (empty) {
+      fen[length++] = char('0' + empty);
+    }
+    fen[length++] = rank ? '/' : ' ';
+  }
+
+  fen[length++] = m_current_move == Piece::Color::WHITE ? 'w' : 'b';
+  fen[length++] = ' ';
+  if (!m_castling_rights) {
+    fen[length++] = '-';
+  }
+  const char castling_chars[] = "KQkq";
+  for (int i = 0; i < 4; ++i) {
+    if (m_castling_rights & (1 << i)) {
+      fen[length++] = castling_chars[i];
     }
   }
+  fen[length++] = ' ';
+  if (contains(m_empassant_target)) {
+    fen[length++] = char('a' + m_empassant_target.get_file());
+    fen[length++] = char('1' + m_empassant_target.get_rank());
+  } else {
+    fen[length++] = '-';
+  }
+  length += std::snprintf(fen + length, sizeof(fen) - length, " %d %d",
+                          m_draw_counter, m_fullmove_number);
+  return std::string(fen, length);
 }
 
 Board &Board::operator=(const Board &b) {
@@ -144,21 +412,115 @@ Board &Board::operator=(const Board &b) {
   return *this;
 }
 
-bool Board::in_check(const Piece::Color color) const {
-  // If any piece of opposite color is attacking color king, board is in check.
-  for (const Piece *piece :
-       get_pieces(color == Piece::Color::WHITE ? Piece::Color::BLACK
-                                               : Piece::Color::WHITE)) {
-    for (const Move &move : piece->get_moves(true)) {
-      if (piece_at(Coordinate(move.get_dest())) &&
-          piece_at(Coordinate(move.get_dest()))->get_type() ==
-              Piece::Type::KING &&
-          piece_at(Coordinate(move.get_dest()))->get_color() == color) {
-        return true;
-      }
+bool Board::is_square_attacked(const Coordinate &coordinate,
+                               const Piece::Color color) const {
+  int square = to_square(coordinate);
+  Bitboard occupied = occupancy();
+  Bitboard queens = pieces(color, Piece::Type::QUEEN);
+
+  // A piece of color attacks square if the same piece type on square would
+  // attack it. Pawns are tested with the capture pattern of the other color.
+  return (pawn_attacks(int(color) ^ 1, square) &
+          pieces(color, Piece::Type::PAWN)) ||
+         (knight_attacks(square) & pieces(color, Piece::Type::KNIGHT)) ||
+         (king_attacks(square) & pieces(color, Piece::Type::KING)) ||
+         (bishop_attacks(square, occupied) &
+          (pieces(color, Piece::Type::BISHOP) | queens)) ||
+         (rook_attacks(square, occupied) &
+          (pieces(color, Piece::Type::ROOK) | queens));
+}
+
+Bitboard Board::attackers_to(const int square, const Bitboard occupied) const {
+  Bitboard rooks = m_pieces[0][int(Piece::Type::ROOK)] |
+                   m_pieces[1][int(Piece::Type::ROOK)] |
+                   m_pieces[0][int(Piece::Type::QUEEN)] |
+                   m_pieces[1][int(Piece::Type::QUEEN)];
+  Bitboard bishops = m_pieces[0][int(Piece::Type::BISHOP)] |
+                     m_pieces[1][int(Piece::Type::BISHOP)] |
+                     m_pieces[0][int(Piece::Type::QUEEN)] |
+                     m_pieces[1][int(Piece::Type::QUEEN)];
+
+  // Same approach as `is_square_attacked`, for both colors at once.
+  return (pawn_attacks(1, square) & m_pieces[0][int(Piece::Type::PAWN)]) |
+         (pawn_attacks(0, square) & m_pieces[1][int(Piece::Type::PAWN)]) |
+         (knight_attacks(square) & (m_pieces[0][int(Piece::Type::KNIGHT)] |
+                                    m_pieces[1][int(Piece::Type::KNIGHT)])) |
+         (king_attacks(square) & (m_pieces[0][int(Piece::Type::KING)] |
+                                  m_pieces[1][int(Piece::Type::KING)])) |
+         (bishop_attacks(square, occupied) & bishops) |
+         (rook_attacks(square, occupied) & rooks);
+}
+
+CheckInfo Board::check_info(const Piece::Color color) const {
+  CheckInfo info;
+  info.checkers = 0;
+  info.check_mask = ~Bitboard(0);
+  info.pinned = 0;
+
+  Bitboard king = pieces(color, Piece::Type::KING);
+  if (!king) {
+    info.king = -1;
+    return info;
+  }
+  info.king = lsb(king);
+
+  Piece::Color opposite_color = (color == Piece::Color::WHITE)
+                                    ? Piece::Color::BLACK
+                                    : Piece::Color::WHITE;
+  Bitboard occupied = occupancy();
+  info.checkers = attackers_to(info.king, occupied) & occupancy(opposite_color);
+  if (popcount(info.checkers) > 1) {
+    info.check_mask = 0;
+  } else if (info.checkers) {
+    info.check_mask = info.checkers | between(info.king, lsb(info.checkers));
+  }
+
+  // A slider seeing the king on an empty board pins the only piece between
+  // them, if that piece is of color.
+  Bitboard queens = pieces(opposite_color, Piece::Type::QUEEN);
+  Bitboard snipers =
+      (rook_attacks(info.king, 0) &
+       (pieces(opposite_color, Piece::Type::ROOK) | queens)) |
+      (bishop_attacks(info.king, 0) &
+       (pieces(opposite_color, Piece::Type::BISHOP) | queens));
+  while (snipers) {
+    Bitboard blockers = between(info.king, pop_lsb(snipers)) & occupied;
+    if (popcount(blockers) == 1) {
+      info.pinned |= blockers & occupancy(color);
     }
   }
-  return false;
+  return info;
+}
+
+bool Board::empassant_legal(const Move &move) const {
+  int from = to_square(move.get_from()), dest = to_square(move.get_dest());
+  Piece::Color color = m_squares[from]->get_color();
+  Piece::Color opposite_color = (color == Piece::Color::WHITE)
+                                    ? Piece::Color::BLACK
+                                    : Piece::Color::WHITE;
+  int captured = (from & ~7) | (dest & 7);
+  Bitboard king = pieces(color, Piece::Type::KING);
+  if (!king) {
+    return true;
+  }
+
+  // Test the king against the position after the capture.
+  Bitboard occupied =
+      (occupancy() ^ square_bb(from) ^ square_bb(captured)) | square_bb(dest);
+  return !(attackers_to(lsb(king), occupied) & occupancy(opposite_color) &
+           ~square_bb(captured));
+}
+
+bool Board::in_check(const Piece::Color color) const {
+  Bitboard king = pieces(color, Piece::Type::KING);
+  if (!king) {
+    return false;
+  }
+
+  // If any piece of opposite color is attacking color king, board is in check.
+  return is_square_attacked(to_coordinate(lsb(king)),
+                            color == Piece::Color::WHITE ? Piece::Color::BLACK
+                                                         : Piece::Color::WHITE);
 }
 
 bool Board::checkmated(const Piece::Color color) const {
@@ -168,12 +530,7 @@ bool Board::checkmated(const Piece::Color color) const {
   }
 
   // If color has no valid moves, color is checkmated.
-  for (const Piece *piece : get_pieces(color)) {
-    if (piece->get_color() == color && !(piece->get_moves().empty())) {
-      return false;
-    }
-  }
-  return true;
+  return !has_moves(color);
 }
 
 bool Board::stalemated(const Piece::Color color) const {
@@ -183,32 +540,28 @@ bool Board::stalemated(const Piece::Color color) const {
   }
 
   // If color has no valid moves, color is stalemated.
-  for (const Piece *piece : get_pieces(color)) {
-    if (piece->get_color() == color && !(piece->get_moves().empty())) {
-      return false;
-    }
-  }
-  return true;
+  return !has_moves(color);
 }
 
 bool Board::draw() const {
-  // If draw counter is not > 8, there exists no draw.
-  if (m_draw_counter < 8) {
-    return false;
-  }
-  if (m_draw_counter >= 50) {
+  // Fifty moves of each color without a capture or pawn move.
+  if (m_draw_counter >= 100) {
     return true;
   }
 
-  // Check move history if in last 8 moves, if moves 0, 1, 2, 3 are the same as
-  // 4, 5, 6, 7; board is in draw.
-  for (int i = m_move_history.size() - 1; i >= int(m_move_history.size()) - 4;
-       --i) {
-    if (!(m_move_history[i] == m_move_history[i - 4])) {
-      return false;
+  // Captures and pawn moves cannot be taken back, so only positions since the
+  // last one can repeat. A position repeats at the earliest four moves later,
+  // with the same color to move. A board set from a FEN string starts with a
+  // draw counter but no history.
+  int window = std::min(m_draw_counter, int(m_key_history.size()));
+  int repetitions = 0;
+  for (int i = 4; i <= window; i += 2) {
+    if (m_key_history[m_key_history.size() - i] == m_key &&
+        ++repetitions == 2) {
+      return true;
     }
   }
-  return true;
+  return false;
 }
 
 Piece *Board::piece_at(const Coordinate &coordinate) {
@@ -216,7 +569,7 @@ Piece *Board::piece_at(const Coordinate &coordinate) {
   if (!contains(coordinate)) {
     return nullptr;
   }
-  return m_board[coordinate.get_rank()][coordinate.get_file()];
+  return m_squares[to_square(coordinate)];
 }
 
 const Piece *Board::piece_at(const Coordinate &coordinate) const {
@@ -224,124 +577,408 @@ const Piece *Board::piece_at(const Coordinate &coordinate) const {
   if (!contains(coordinate)) {
     return nullptr;
   }
-  return m_board[coordinate.get_rank()][coordinate.get_file()];
+  return m_squares[to_square(coordinate)];
 }
 
 std::vector<Piece *> Board::get_pieces(const Piece::Color color) {
-  // Iterate through board, add any piece of color to vector.
+  // Iterate through occupied squares of color, add each piece to vector.
   std::vector<Piece *> pieces;
-  for (int rank = 0; rank < SIZE; ++rank) {
-    for (int file = 0; file < SIZE; ++file) {
-      Piece *piece = piece_at(Coordinate(rank, file));
-      if (piece != nullptr && piece->get_color() == color) {
-        pieces.push_back(piece);
-      }
-    }
+  Bitboard occupied = occupancy(color);
+  while (occupied) {
+    pieces.push_back(m_squares[pop_lsb(occupied)]);
   }
   return pieces;
 }
 
 std::vector<const Piece *> Board::get_pieces(const Piece::Color color) const {
-  // Iterate through board, add any piece of color to vector.
+  // Iterate through occupied squares of color, add each piece to vector.
   std::vector<const Piece *> pieces;
-  for (int rank = 0; rank < SIZE; ++rank) {
-    for (int file = 0; file < SIZE; ++file) {
-      const Piece *piece = piece_at(Coordinate(rank, file));
-      if (piece != nullptr && piece->get_color() == color) {
-        pieces.push_back(piece);
-      }
-    }
+  Bitboard occupied = occupancy(color);
+  while (occupied) {
+    pieces.push_back(m_squares[pop_lsb(occupied)]);
   }
   return pieces;
 }
 
-std::vector<Move> Board::get_moves(const Piece::Color color) const {
-  // Iterate through pieces, add all valid moves to vector.
-  std::vector<Move> moves;
-  std::vector<const Piece *> pieces = get_pieces(color);
-  for (const Piece *piece : pieces) {
-    std::vector<Move> piece_moves = piece->get_moves();
-    moves.insert(moves.end(), piece_moves.begin(), piece_moves.end());
+void Board::get_moves(const Piece::Color color, MoveList &moves) const {
+  get_moves(color, moves, check_info(color), ~Bitboard(0));
+}
+
+void Board::get_moves(const Piece::Color color, MoveList &moves,
+                      const CheckInfo &info, const Bitboard filter) const {
+  // Iterate through pieces, add all valid moves to list. Only the king can
+  // move out of double check.
+  Bitboard occupied = info.check_mask ? occupancy(color)
+                                      : pieces(color, Piece::Type::KING);
+  while (occupied) {
+    m_squares[pop_lsb(occupied)]->get_moves(moves, info, filter);
   }
-  return moves;
 }
 
-void Board::copy(const Board &b) {
-  // Build 2-D array of piece pointers.
-  m_board = new Piece **[SIZE];
-  for (int rank = 0; rank < SIZE; ++rank) {
-    m_board[rank] = new Piece *[SIZE];
-    for (int file = 0; file < SIZE; ++file) {
-      m_board[rank][file] = nullptr;
+bool Board::has_moves(const Piece::Color color) const {
+  // Same iteration as `get_moves`, returning once any piece can move.
+  CheckInfo info = check_info(color);
+  Bitboard occupied = info.check_mask ? occupancy(color)
+                                      : pieces(color, Piece::Type::KING);
+  while (occupied) {
+    MoveList moves;
+    m_squares[pop_lsb(occupied)]->get_moves(moves, info);
+    if (!moves.empty()) {
+      return true;
     }
   }
+  return false;
+}
 
+int Board::see(const Move &move) const {
+  int from = to_square(move.get_from()), dest = to_square(move.get_dest());
+  Bitboard occupied = occupancy() ^ square_bb(from);
+
+  // Material gained after each capture in the sequence, from the perspective
+  // of the side making that capture.
+  int gain[MAX_PIECES];
+  int depth = 0;
+  if (move.get_type() == Move::MoveType::EM_PASSANT) {
+    occupied ^= square_bb((from & ~7) | (dest & 7));
+    gain[0] = see_value(Piece::Type::PAWN);
+  } else {
+    gain[0] = m_squares[dest] ? see_value(m_squares[dest]->get_type()) : 0;
+  }
+
+  Bitboard rooks = m_pieces[0][int(Piece::Type::ROOK)] |
+                   m_pieces[1][int(Piece::Type::ROOK)] |
+                   m_pieces[0][int(Piece::Type::QUEEN)] |
+                   m_pieces[1][int(Piece::Type::QUEEN)];
+  Bitboard bishops = m_pieces[0][int(Piece::Type::BISHOP)] |
+                     m_pieces[1][int(Piece::Type::BISHOP)] |
+                     m_pieces[0][int(Piece::Type::QUEEN)] |
+                     m_pieces[1][int(Piece::Type::QUEEN)];
+  Bitboard attackers = attackers_to(dest, occupied) & occupied;
+  Piece::Type attacker = m_squares[from]->get_type();
+  Piece::Color color = m_squares[from]->get_color() == Piece::Color::WHITE
+                           ? Piece::Color::BLACK
+                           : Piece::Color::WHITE;
+  while (depth + 1 < MAX_PIECES) {
+    // Speculatively capture the last attacker, stop once neither side can
+    // gain from continuing.
+    ++depth;
+    gain[depth] = see_value(attacker) - gain[depth - 1];
+    if (std::max(-gain[depth - 1], gain[depth]) < 0) {
+      break;
+    }
+
+    // Least valuable attacker of color recaptures next.
+    Bitboard own = attackers & occupancy(color);
+    if (!own) {
+      break;
+    }
+    int type = 0;
+    while (!(own & m_pieces[int(color)][type])) {
+      ++type;
+    }
+    occupied ^= square_bb(lsb(own & m_pieces[int(color)][type]));
+    attacker = Piece::Type(type);
+
+    // Removing the attacker can uncover a slider behind it.
+    attackers |= (bishop_attacks(dest, occupied) & bishops) |
+                 (rook_attacks(dest, occupied) & rooks);
+    attackers &= occupied;
+    color = color == Piece::Color::WHITE ? Piece::Color::BLACK
+                                         : Piece::Color::WHITE;
+  }
+
+  // Each side picks the better of capturing or standing pat.
+  while (--depth) {
+    gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+  }
+  return gain[0];
+}
+
+void Board::copy(const Board &b) {
   // Copy board data
+  for (int color = 0; color < 2; ++color) {
+    for (int type = 0; type < 6; ++type) {
+      m_pieces[color][type] = b.m_pieces[color][type];
+    }
+    m_occupancy[color] = b.m_occupancy[color];
+  }
   m_current_move = b.m_current_move;
   m_draw_counter = b.m_draw_counter;
+  m_fullmove_number = b.m_fullmove_number;
+  m_castling_rights = b.m_castling_rights;
   m_empassant_target = Coordinate(b.m_empassant_target);
+  m_key = b.m_key;
+  m_score_mg = b.m_score_mg;
+  m_score_eg = b.m_score_eg;
+  m_phase = b.m_phase;
 
-  for (Move move : b.m_move_history) {
-    m_move_history.push_back(move);
-  }
+  // Undo records are not copied, the copy starts a new line of play. Only keys
+  // of the positions the current one can still repeat are needed.
+  size_t window = std::min(size_t(b.m_draw_counter), b.m_key_history.size());
+  m_key_history.assign(b.m_key_history.end() - window, b.m_key_history.end());
 
-  // Create every piece object that exists on copied board.
-  for (int rank = 0; rank < SIZE; ++rank) {
-    for (int file = 0; file < SIZE; ++file) {
-      if (b.piece_at(Coordinate(rank, file))) {
-        switch (b.piece_at(Coordinate(rank, file))->get_type()) {
-        case Piece::Type::PAWN:
-          m_board[rank][file] =
-              new Pawn(this, b.piece_at(Coordinate(rank, file))->get_color(),
-                       Coordinate(rank, file),
-                       b.piece_at(Coordinate(rank, file))->get_moved());
-          break;
-        case Piece::Type::KNIGHT:
-          m_board[rank][file] =
-              new Knight(this, b.piece_at(Coordinate(rank, file))->get_color(),
-                         Coordinate(rank, file));
-          break;
-        case Piece::Type::BISHOP:
-          m_board[rank][file] =
-              new Bishop(this, b.piece_at(Coordinate(rank, file))->get_color(),
-                         Coordinate(rank, file));
-          break;
-        case Piece::Type::ROOK:
-          m_board[rank][file] =
-              new Rook(this, b.piece_at(Coordinate(rank, file))->get_color(),
-                       Coordinate(rank, file),
-                       b.piece_at(Coordinate(rank, file))->get_moved());
-          break;
-        case Piece::Type::QUEEN:
-          m_board[rank][file] =
-              new Queen(this, b.piece_at(Coordinate(rank, file))->get_color(),
-                        Coordinate(rank, file));
-          break;
-        case Piece::Type::KING:
-          m_board[rank][file] =
-              new King(this, b.piece_at(Coordinate(rank, file))->get_color(),
-                       Coordinate(rank, file),
-                       b.piece_at(Coordinate(rank, file))->get_moved());
-          break;
-        }
-      }
-    }
+  // Create every piece object that exists on copied board in this board's
+  // piece pool.
+  m_piece_count = 0;
+  for (int square = 0; square < SIZE * SIZE; ++square) {
+    const Piece *piece = b.m_squares[square];
+    m_squares[square] =
+        piece == nullptr
+            ? nullptr
+            : new_piece(piece->get_type(), piece->get_color(),
+                        piece->get_coordinate(), piece->get_moved());
   }
 
   return;
 }
 
 void Board::destroy() {
-  for (int rank = 0; rank < SIZE; ++rank) {
-    for (int file = 0; file < SIZE; ++file) {
-      delete m_board[rank][file];
-    }
-    delete[] m_board[rank];
+  // Pieces on the board and pieces held off the board by undo records are all
+  // in the piece pool.
+  for (int i = 0; i < m_piece_count; ++i) {
+    reinterpret_cast<Piece *>(&m_piece_pool[i])->~Piece();
   }
-  delete[] m_board;
+  m_piece_count = 0;
+  m_undo_stack.clear();
   return;
 }
 
+Piece *Board::new_piece(const Piece::Type type, const Piece::Color color,
+                        const Coordinate &coordinate, const bool moved) {
+  return construct_piece(&m_piece_pool[m_piece_count++], this, type, color,
+                         coordinate, moved);
+}
+
+Piece *Board::replace_piece(Piece *piece, const Piece::Type type) {
+  Piece::Color color = piece->get_color();
+  Coordinate coordinate = piece->get_coordinate();
+  bool moved = piece->get_moved();
+  void *slot = piece;
+
+  piece->~Piece();
+  return construct_piece(slot, this, type, color, coordinate, moved);
+}
+
+uint64_t Board::compute_key() const {
+  uint64_t key = 0;
+  for (int color = 0; color < 2; ++color) {
+    for (int type = 0; type < 6; ++type) {
+      Bitboard squares = m_pieces[color][type];
+      while (squares) {
+        key ^= zobrist_pieces[color][type][pop_lsb(squares)];
+      }
+    }
+  }
+  key ^= zobrist_castling[m_castling_rights];
+  if (m_current_move == Piece::Color::BLACK) {
+    key ^= zobrist_side;
+  }
+  return key ^ empassant_key();
+}
+
+uint64_t Board::empassant_key() const {
+  if (m_empassant_target == Coordinate(-1, -1)) {
+    return 0;
+  }
+
+  // Squares a pawn of color to move would capture onto the target from.
+  Bitboard capturers = pawn_attacks(int(m_current_move) ^ 1,
+                                    to_square(m_empassant_target)) &
+                       pieces(m_current_move, Piece::Type::PAWN);
+  return capturers ? zobrist_empassant[m_empassant_target.get_file()] : 0;
+}
+
+void Board::put_piece(Piece *piece) {
+  int square = to_square(piece->get_coordinate());
+  int color = int(piece->get_color()), type = int(piece->get_type());
+  m_squares[square] = piece;
+  m_key ^= zobrist_pieces[color][type][square];
+  m_pieces[color][type] |= square_bb(square);
+  m_occupancy[color] |= square_bb(square);
+  m_score_mg += piece_square_mg[color][type][square];
+  m_score_eg += piece_square_eg[color][type][square];
+  m_phase += PHASE_WEIGHTS[type];
+}
+
+Piece *Board::remove_piece(const int square) {
+  Piece *piece = m_squares[square];
+  int color = int(piece->get_color()), type = int(piece->get_type());
+  m_squares[square] = nullptr;
+  m_key ^= zobrist_pieces[color][type][square];
+  m_pieces[color][type] &= ~square_bb(square);
+  m_occupancy[color] &= ~square_bb(square);
+  m_score_mg -= piece_square_mg[color][type][square];
+  m_score_eg -= piece_square_eg[color][type][square];
+  m_phase -= PHASE_WEIGHTS[type];
+  return piece;
+}
+
+void Board::make_move(const Move &move) {
+  int from = to_square(move.get_from()), dest = to_square(move.get_dest());
+  int rank = move.get_dest().get_rank(), file = move.get_dest().get_file();
+  Piece *piece = m_squares[from];
+  Piece::Color color = piece->get_color();
+
+  // Save board state to restore in `unmake_move`.
+  UndoRecord record;
+  record.move = move;
+  record.captured = nullptr;
+  record.moved = piece->m_moved;
+  record.castling_rights = m_castling_rights;
+  record.empassant_target = m_empassant_target;
+  record.draw_counter = m_draw_counter;
+  record.key = m_key;
+
+  // Remove castling and em passant keys of current state, pieces update key as
+  // they are put and removed.
+  m_key ^= zobrist_castling[m_castling_rights] ^ empassant_key();
+
+  // Update draw counter on board.
+  if (m_squares[dest] != nullptr || piece->get_type() == Piece::Type::PAWN) {
+    m_draw_counter = 0;
+  } else {
+    m_draw_counter += 1;
+  }
+
+  // Phyiscally move piece on board. Captured piece is held by undo record.
+  remove_piece(from);
+  if (m_squares[dest] != nullptr) {
+    record.captured = remove_piece(dest);
+  }
+  piece->m_moved = true;
+  piece->m_coordinate = move.get_dest();
+  put_piece(piece);
+
+  // Update `m_empassant_target` if pawn double move.
+  if (move.get_type() == Move::MoveType::DOUBLE) {
+    m_empassant_target =
+        Coordinate(rank + ((color == Piece::Color::WHITE) ? -1 : 1), file);
+  } else {
+    m_empassant_target = Coordinate(-1, -1);
+  }
+
+  // Moving a king or rook, or capturing a rook, loses castling rights.
+  m_castling_rights &= castling_mask(from) & castling_mask(dest);
+
+  /*
+    Handle special case moves.
+
+    1. Change piece type if pawn promotion. Pawn is reconstructed in place.
+    2. Move rook if castling move.
+    3. Remove enemy pawn if em passant move.
+  */
+  Piece *rook;
+  switch (move.get_type()) {
+  case Move::MoveType::KNIGHT_PROMOTION:
+    put_piece(replace_piece(remove_piece(dest), Piece::Type::KNIGHT));
+    break;
+
+  case Move::MoveType::BISHOP_PROMOTION:
+    put_piece(replace_piece(remove_piece(dest), Piece::Type::BISHOP));
+    break;
+
+  case Move::MoveType::ROOK_PROMOTION:
+    put_piece(replace_piece(remove_piece(dest), Piece::Type::ROOK));
+    break;
+
+  case Move::MoveType::QUEEN_PROMOTION:
+    put_piece(replace_piece(remove_piece(dest), Piece::Type::QUEEN));
+    break;
+
+  case Move::MoveType::QUEEN_CASTLE:
+    rook = remove_piece(to_square(Coordinate(rank, 0)));
+    rook->m_coordinate = Coordinate(rank, file + 1);
+    rook->m_moved = true;
+    put_piece(rook);
+    break;
+
+  case Move::MoveType::KING_CASTLE:
+    rook = remove_piece(to_square(Coordinate(rank, SIZE - 1)));
+    rook->m_coordinate = Coordinate(rank, file - 1);
+    rook->m_moved = true;
+    put_piece(rook);
+    break;
+
+  case Move::MoveType::EM_PASSANT:
+    record.captured = remove_piece(to_square(
+        Coordinate(rank + (color == Piece::Color::WHITE ? -1 : 1), file)));
+    break;
+
+  default:
+    break;
+  }
+
+  // Add keys of new state.
+  if (m_current_move == Piece::Color::BLACK) {
+    m_key ^= zobrist_side;
+  }
+  if (color == Piece::Color::BLACK) {
+    ++m_fullmove_number;
+  }
+  m_current_move = (color == Piece::Color::WHITE) ? Piece::Color::BLACK
+                                                  : Piece::Color::WHITE;
+  if (m_current_move == Piece::Color::BLACK) {
+    m_key ^= zobrist_side;
+  }
+  m_key ^= zobrist_castling[m_castling_rights] ^ empassant_key();
+
+  m_key_history.push_back(record.key);
+  m_undo_stack.push_back(record);
+}
+
+void Board::unmake_move() {
+  const UndoRecord &record = m_undo_stack.back();
+  const Move &move = record.move;
+  int rank = move.get_dest().get_rank(), file = move.get_dest().get_file();
+
+  // Move rook back if castling move.
+  Piece *rook;
+  switch (move.get_type()) {
+  case Move::MoveType::QUEEN_CASTLE:
+    rook = remove_piece(to_square(Coordinate(rank, file + 1)));
+    rook->m_coordinate = Coordinate(rank, 0);
+    rook->m_moved = false;
+    put_piece(rook);
+    break;
+
+  case Move::MoveType::KING_CASTLE:
+    rook = remove_piece(to_square(Coordinate(rank, file - 1)));
+    rook->m_coordinate = Coordinate(rank, SIZE - 1);
+    rook->m_moved = false;
+    put_piece(rook);
+    break;
+
+  default:
+    break;
+  }
+
+  // Take moved piece off destination, turning a promoted piece back into the
+  // pawn.
+  Piece *piece = remove_piece(to_square(move.get_dest()));
+  if (is_promotion(move)) {
+    piece = replace_piece(piece, Piece::Type::PAWN);
+  }
+
+  // Restore moved piece and captured piece.
+  piece->m_coordinate = move.get_from();
+  piece->m_moved = record.moved;
+  put_piece(piece);
+  if (record.captured != nullptr) {
+    put_piece(record.captured);
+  }
+
+  m_castling_rights = record.castling_rights;
+  m_empassant_target = record.empassant_target;
+  m_draw_counter = record.draw_counter;
+  m_key = record.key;
+  m_current_move = piece->get_color();
+  if (m_current_move == Piece::Color::BLACK) {
+    --m_fullmove_number;
+  }
+  m_key_history.pop_back();
+  m_undo_stack.pop_back();
+}
+
 std::ostream &operator<<(std::ostream &os, const Board &b) {
   for (int rank = b.SIZE - 1; rank >= 0; --rank) {
     for (int file = 0; file < b.SIZE; ++file) {
@@ -387,144 +1024,9 @@ std::ostream &operator<<(std::ostream &os, const Board &b) {
 ////////////////////////////////////////////////////////////////////////////////
 
 int Board::get_score(const Piece::Color color) const {
-  int score = 0;
-  Piece::Color opposite_color = (color == Piece::Color::WHITE)
-                                    ? Piece::Color::BLACK
-                                    : Piece::Color::WHITE;
-  for (const Piece *piece : get_pieces(color)) {
-    switch (piece->get_type()) {
-    case Piece::Type::PAWN:
-      score += 1;
-      break;
-    case Piece::Type::KNIGHT:
-      score += 3;
-      break;
-    case Piece::Type::BISHOP:
-      score += 3;
-      break;
-    case Piece::Type::ROOK:
-      score += 5;
-      break;
-    case Piece::Type::QUEEN:
-      score += 9;
-      break;
-    case Piece::Type::KING:
-      score += 4;
-      break;
-    }
-  }
-  for (const Piece *piece : get_pieces(opposite_color)) {
-    switch (piece->get_type()) {
-    case Piece::Type::PAWN:
-      score -= 1;
-      break;
-    case Piece::Type::KNIGHT:
-      score -= 3;
-      break;
-    case Piece::Type::BISHOP:
-      score -= 3;
-      break;
-    case Piece::Type::ROOK:
-      score -= 5;
-      break;
-    case Piece::Type::QUEEN:
-      score -= 9;
-      break;
-    case Piece::Type::KING:
-      score -= 4;
-      break;
-    }
-  }
-  return score;
-}
-
-Move find_move(const Board &b, Piece::Color color) {
-  const int MAX_DEPTH = 3;
-  std::pair<Move, int> choice_action(Move(), INT_MIN),
-      max_action(Move(), INT_MIN);
-
-  // Use iterative deepening to find best move using depth limited minimax
-  for (int i = 1; i < MAX_DEPTH; ++i) {
-    Board choice_board(b);
-    choice_action = max_choice(choice_board, color, i);
-    if (choice_action.second > max_action.second) {
-      max_action = choice_action;
-    }
-  }
-  return max_action.first;
-}
-
-std::pair<Move, int> max_choice(const Board &b, Piece::Color color, int depth) {
-  int action_val = 0;
-  std::pair<Move, int> max_action(Move(), INT_MIN);
-
-  // Depth limited minimax
-  for (const Move move : b.get_moves(color)) {
-    Board choice_board(b);
-    choice_board.piece_at(move.get_from())->move(move);
-    action_val = min_value(choice_board, color, depth - 1);
-    if (action_val > max_action.second) {
-      max_action = std::pair<Move, int>(move, action_val);
-    }
-  }
-  return max_action;
-}
-
-int min_value(const Board &b, Piece::Color color, int depth) {
-  int action_val = 0, min_action = INT_MAX - 1;
-  Piece::Color opposite_color = (color == Piece::Color::WHITE)
-                                    ? Piece::Color::BLACK
-                                    : Piece::Color::WHITE;
-
-  // Avoid draw/stalemate other color
-  if (b.draw() || b.stalemated(opposite_color)) {
-    return INT_MIN + 1;
-  }
-  // Prefer check/checkmate other color
-  if (b.in_check(opposite_color) || b.checkmated(opposite_color)) {
-    return min_action;
-  }
-  // Base case
-  if (depth == 0) {
-    return b.get_score(color);
-  }
-
-  // Iterate through every valid move
-  for (const Move move : b.get_moves(opposite_color)) {
-    Board choice_board(b);
-    choice_board.piece_at(move.get_from())->move(move);
-    action_val = max_value(choice_board, color, depth - 1);
-    if (action_val < min_action) {
-      min_action = action_val;
-    }
-  }
-  return min_action;
-}
-
-int max_value(const Board &b, Piece::Color color, int depth) {
-  int action_val = 0, max_action = INT_MIN + 1;
-
-  // Avoid draw/stalemate other color
-  if (b.draw() || b.stalemated(color)) {
-    return INT_MAX - 1;
-  }
-  // Prefer check/checkmate other color
-  if (b.in_check(color) || b.checkmated(color)) {
-    return max_action;
-  }
-  // Base case
-  if (depth == 0) {
-    return b.get_score(color);
-  }
-
-  // Iterate through every valid move
-  for (const Move move : b.get_moves(color)) {
-    Board choice_board(b);
-    choice_board.piece_at(move.get_from())->move(move);
-    action_val = min_value(choice_board, color, depth - 1);
-    if (action_val > max_action) {
-      max_action = action_val;
-    }
-  }
-  return max_action;
-}
+  // Promotions can raise the phase above that of the starting material.
+  int phase = std::min(m_phase, MAX_PHASE);
+  int score = (m_score_mg * phase + m_score_eg * (MAX_PHASE - phase)) /
+              MAX_PHASE;
+  return color == Piece::Color::WHITE ? score : -score;
+}
\ No newline at end of file
@@ -1,23 +1,84 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include "bitboard.h"
 #include "coordinate.h"
 #include "move.h"
+#include "movelist.h"
 #include "piece.h"
 
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 /**
- * Chess board class. Contains board storage of pieces pointers and utility
- * functions to operator on and obtain data from board.
+ * Legality masks of one color, computed once per position so moves can be
+ * generated legal without playing them.
+ */
+struct CheckInfo {
+  /// Square index of king, -1 if color has no king.
+  int king;
+
+  /// Pieces of the other color giving check.
+  Bitboard checkers;
+
+  /// Squares a piece other than the king may move to. The checker and the
+  /// squares between it and the king if in single check, no squares if in
+  /// double check, every square otherwise.
+  Bitboard check_mask;
+
+  /// Pieces of color pinned to their king, which may only move along the
+  /// line through the king.
+  Bitboard pinned;
+};
+
+/**
+ * Reasons a FEN string is rejected, NONE if it is valid.
+ */
+enum class FenError {
+  NONE,
+  /// Unknown piece letter, rank not of 8 files, not 8 ranks, or pawn on the
+  /// first or last rank.
+  PIECE_PLACEMENT,
+  /// More than `Board::MAX_PIECES` pieces.
+  TOO_MANY_PIECES,
+  SIDE_TO_MOVE,
+  CASTLING_RIGHTS,
+  /// Target not on the rank behind a pawn of the color that just moved, or
+  /// the target or the square the pawn came from is occupied.
+  EM_PASSANT_TARGET,
+  HALFMOVE_CLOCK,
+  FULLMOVE_NUMBER
+};
+
+/**
+ * Chess board class. Stores the position as one bitboard per piece color and
+ * type, with piece objects kept per square as a view over the bitboards, and
+ * utility functions to operator on and obtain data from board.
  */
 class Board {
 public:
   /// Constant dimensions of chess board.
   static const int SIZE = 8;
 
+  /// Maximum number of piece objects on a board.
+  static const int MAX_PIECES = 32;
+
+  /// Layout of the starting position.
+  static constexpr std::string_view START_FEN =
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+  /// Layout of a board without pieces, used in place of an invalid position.
+  static constexpr std::string_view EMPTY_FEN = "8/8/8/8/8/8/8/8 w - - 0 1";
+
+  /// Castling right flags stored in `m_castling_rights`.
+  static const int WHITE_KING_CASTLE = 1;
+  static const int WHITE_QUEEN_CASTLE = 2;
+  static const int BLACK_KING_CASTLE = 4;
+  static const int BLACK_QUEEN_CASTLE = 8;
+
   friend class Piece;
   friend class Pawn;
 
@@ -27,12 +88,14 @@ public:
   Board();
 
   /**
-   * Constructs board object with provided fen layout.
+   * Constructs board object with provided fen layout. The board is left empty
+   * if `fen` is not valid, use `set_fen` to find out why.
    *
    * @param fen Layout of current chess board state, (e.g.
-   * rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1).
+   * rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1). At most
+   * `MAX_PIECES` pieces.
    */
-  Board(const std::string fen);
+  Board(const std::string_view fen);
 
   /**
    * Constructs board object from provided board.
@@ -54,6 +117,26 @@ public:
    */
   ~Board() { destroy(); }
 
+  /**
+   * Sets the board to a FEN layout in a single pass without allocating. All
+   * six fields are read, the halfmove clock and fullmove number may be left
+   * out together (defaulting to 0 and 1). Castling rights whose king or rook
+   * is not on its starting square are dropped. The board is only changed if
+   * `fen` is valid.
+   *
+   * @param fen Layout of chess board state.
+   * @return FenError::NONE if set, otherwise the first field found invalid.
+   */
+  FenError set_fen(const std::string_view fen);
+
+  /**
+   * Writes the board as a FEN layout. The em passant target is written after
+   * every double pawn move, whether or not a capture is possible.
+   *
+   * @return FEN string of board.
+   */
+  std::string to_fen() const;
+
   /**
    * Determines if a coordinate is within the board.
    *
@@ -65,6 +148,34 @@ public:
            coordinate.get_rank() < SIZE && coordinate.get_file() < SIZE;
   }
 
+  /**
+   * Determines if a square is attacked by any piece of the provided color.
+   * Works outward from the square with the attack pattern of each piece type.
+   *
+   * @param coordinate Coordinate of square to test.
+   * @param color Color of attacking pieces.
+   * @return Boolean value if `coordinate` is attacked by `color`.
+   */
+  bool is_square_attacked(const Coordinate &coordinate,
+                          const Piece::Color color) const;
+
+  /**
+   * Finds every piece of either color attacking a square.
+   *
+   * @param square Square index to test.
+   * @param occupied Bitboard of occupied squares blocking sliders.
+   * @return Bitboard of pieces attacking `square`.
+   */
+  Bitboard attackers_to(const int square, const Bitboard occupied) const;
+
+  /**
+   * Computes the checkers, check mask and pinned pieces of a color.
+   *
+   * @param color Color to compute legality masks of.
+   * @return Legality masks of `color`.
+   */
+  CheckInfo check_info(const Piece::Color color) const;
+
   /**
    * Determines if the provided color is in check in current board state.
    *
@@ -90,7 +201,9 @@ public:
   bool stalemated(const Piece::Color color) const;
 
   /**
-   * Determines if there is a draw on the current board state.
+   * Determines if there is a draw on the current board state, by the
+   * fifty-move rule or by the position occurring for the third time with the
+   * same color to move, castling rights and em passant target.
    *
    * @return Boolean value if board state is in draw.
    */
@@ -114,6 +227,37 @@ public:
    */
   const Piece *piece_at(const Coordinate &coordinate) const;
 
+  /**
+   * Getter for the bitboard of pieces of a given color and type.
+   *
+   * @param color Color of pieces.
+   * @param type Type of pieces.
+   * @return Bitboard of squares occupied by `color` pieces of `type`.
+   */
+  Bitboard pieces(const Piece::Color color, const Piece::Type type) const {
+    return m_pieces[int(color)][int(type)];
+  }
+
+  /**
+   * Getter for the bitboard of pieces of a given color.
+   *
+   * @param color Color of pieces.
+   * @return Bitboard of squares occupied by `color`.
+   */
+  Bitboard occupancy(const Piece::Color color) const {
+    return m_occupancy[int(color)];
+  }
+
+  /**
+   * Getter for the bitboard of all pieces.
+   *
+   * @return Bitboard of occupied squares.
+   */
+  Bitboard occupancy() const {
+    return m_occupancy[int(Piece::Color::WHITE)] |
+           m_occupancy[int(Piece::Color::BLACK)];
+  }
+
   /**
    * Construct vector of piece pointers of a given color
    *
@@ -131,26 +275,93 @@ public:
   std::vector<const Piece *> get_pieces(const Piece::Color color) const;
 
   /**
-   * Construct vector of valid moves of a given color
+   * Construct list of valid moves of a given color
+   *
+   * @param color Color to get moves of.
+   * @param moves List to append moves of `color` to.
+   */
+  void get_moves(const Piece::Color color, MoveList &moves) const;
+
+  /**
+   * Construct list of valid moves of a given color landing on a set of
+   * squares, with legality masks already computed.
    *
    * @param color Color to get moves of.
-   * @return Vector of moves of `color`.
+   * @param moves List to append moves of `color` to.
+   * @param info Legality masks of `color`.
+   * @param filter Bitboard of destination squares to keep.
    */
-  std::vector<Move> get_moves(const Piece::Color color) const;
+  void get_moves(const Piece::Color color, MoveList &moves,
+                 const CheckInfo &info, const Bitboard filter) const;
 
   /**
-   * Appends move to `m_move_history`.
+   * Determines if a color has at least one valid move, stopping at the first
+   * piece that can move.
    *
-   * @param move Move to add to move history.
+   * @param color Color to check moves of.
+   * @return Boolean value if `color` has a valid move.
    */
-  void add_move(const Move &move) { m_move_history.push_back(move); }
+  bool has_moves(const Piece::Color color) const;
+
+  /**
+   * Static exchange evaluation of a move. Plays out every capture on the
+   * destination square, least valuable attacker first, with either side
+   * free to stop when further captures lose material.
+   *
+   * @param move Move to evaluate, origin must hold a piece.
+   * @return Material won by the side moving, in centipawns (negative if the
+   * exchange loses material).
+   */
+  int see(const Move &move) const;
+
+  /**
+   * Plays a move on the board in place. The state needed to take the move back
+   * is pushed onto `m_undo_stack`.
+   *
+   * @param move Move to carry out, origin must hold a piece.
+   */
+  void make_move(const Move &move);
+
+  /**
+   * Takes back the last move played with `make_move`, restoring the board to
+   * the exact state before that move.
+   */
+  void unmake_move();
 
   /**
    * Getter for `m_empassant_target`.
    *
    * @return Coordinate of the current em passant target.
    */
-  Coordinate get_empassant_target() { return m_empassant_target; }
+  Coordinate get_empassant_target() const { return m_empassant_target; }
+
+  /**
+   * Getter for `m_fullmove_number`.
+   *
+   * @return Number of the current full move, starting at 1.
+   */
+  int get_fullmove_number() const { return m_fullmove_number; }
+
+  /**
+   * Getter for `m_current_move`.
+   *
+   * @return Color to move.
+   */
+  Piece::Color get_current_move() const { return m_current_move; }
+
+  /**
+   * Getter for `m_key`.
+   *
+   * @return Zobrist key of the current position.
+   */
+  uint64_t get_key() const { return m_key; }
+
+  /**
+   * Getter for `m_castling_rights`.
+   *
+   * @return Castling right flags still available on board.
+   */
+  int get_castling_rights() const { return m_castling_rights; }
 
   /**
    * Overload insertion operator for board object.
@@ -166,79 +377,100 @@ public:
   ////////////////////////////////////////////////////////////////////////////////
 
   /**
-   * Calculates score of `color` using standard piece valutations.
-   * Used as the heuristic function for the move selection algorithm.
+   * Calculates score of `color` from material and piece-square values, in
+   * centipawns. Used as the heuristic function for the move selection
+   * algorithm.
    *
-   * (pawn : 1, knight : 3, bishop : 3, rook : 5, queen : 9, king : 4).
+   * Middlegame and endgame sums are kept up to date as pieces are put and
+   * removed, and are interpolated by the remaining material (game phase).
    *
    * @param color Color to get score of.
-   * @return Total piece value of `color`.
+   * @return Evaluation of board from the perspective of `color`.
    */
   int get_score(const Piece::Color color) const;
 
+private:
   /**
-   * Finds best move using the assignment specified algorithm.
-   * This assignment is using Iterative-Deepening Depth-Limited MiniMax.
-   *
-   * @param b Board to find move on.
-   * @param color Color to find move of.
-   * @return Move found using algorithm.
+   * State saved by `make_move` to restore the board in `unmake_move`.
    */
-  friend Move find_move(const Board &b, Piece::Color color);
+  struct UndoRecord {
+    /// Move that was played.
+    Move move;
 
-  /**
-   * Find the best move at the current depth limit.
-   *
-   * @param b Board to find move on.
-   * @param color Color to find move of.
-   * @param depth Current depth limit.
-   * @return Pair of move and int score of best move.
-   */
-  friend std::pair<Move, int> max_choice(const Board &b, Piece::Color color,
-                                         int depth);
+    /// Piece captured by the move, nullptr if no capture.
+    Piece *captured;
 
-  /**
-   * Find the best move for other color at the current depth limit.
-   *
-   * @param b Board to find move on.
-   * @param color Color to find move of.
-   * @param depth Current depth limit.
-   * @return Int score of best move.
-   */
-  friend int min_value(const Board &b, Piece::Color color, int depth);
+    /// `m_moved` of the moving piece before the move.
+    bool moved;
 
-  /**
-   * Find the best move at the current depth limit.
-   *
-   * @param b Board to find move on.
-   * @param color Color to find move of.
-   * @param depth Current depth limit.
-   * @return Int score of best move.
-   */
-  friend int max_value(const Board &b, Piece::Color color, int depth);
+    /// Castling rights before the move.
+    int castling_rights;
 
-private:
-  /// 2-D array of piece pointers represeting the physical board.
-  Piece ***m_board;
+    /// Em passant target before the move.
+    Coordinate empassant_target;
+
+    /// Draw counter before the move.
+    int draw_counter;
+
+    /// Zobrist key before the move.
+    uint64_t key;
+  };
+
+  /// Bitboards of pieces indexed by color then type.
+  Bitboard m_pieces[2][6];
+
+  /// Bitboards of all pieces of each color.
+  Bitboard m_occupancy[2];
+
+  /// Piece object on each square, indexed by square. nullptr if empty.
+  Piece *m_squares[SIZE * SIZE];
+
+  /// Storage of one piece object of any type. Piece classes only override
+  /// functions, so each has the size of `Piece`.
+  typedef std::aligned_storage<sizeof(Piece), alignof(Piece)>::type PieceSlot;
+
+  /// Piece objects of board, constructed in place so boards never allocate
+  /// pieces. Captured pieces keep their slot while held by an undo record.
+  PieceSlot m_piece_pool[MAX_PIECES];
+
+  /// Number of pieces constructed in `m_piece_pool`.
+  int m_piece_count;
+
+  /// Zobrist keys of the positions before each move played, most recent last.
+  /// Only the last `m_draw_counter` keys can repeat the current position, so
+  /// copies of the board only take those.
+  std::vector<uint64_t> m_key_history;
+
+  /// Undo records of moves played with `make_move`, most recent last.
+  std::vector<UndoRecord> m_undo_stack;
 
-  /// Move history of board.
-  std::vector<Move> m_move_history;
+  /// Castling right flags (e.g. WHITE_KING_CASTLE | BLACK_QUEEN_CASTLE).
+  int m_castling_rights;
 
   /// Coordinate of current em passant target. {-1, -1} if no target.
   Coordinate m_empassant_target;
 
-  /// Counter until draw if eligible.
+  /// Counter until draw if eligible, the number of moves since the last
+  /// capture or pawn move (halfmove clock).
   int m_draw_counter;
 
+  /// Number of the current full move, incremented after each black move.
+  int m_fullmove_number;
+
   /// Current color to move.
   Piece::Color m_current_move;
 
-  /**
-   * Helper function for default and parameter constructors.
-   *
-   * @param fen String to construct board from.
-   */
-  void constructor(const std::string fen);
+  /// Zobrist key of piece placement, color to move, castling rights and em
+  /// passant target. Updated incrementally as pieces are put and removed.
+  uint64_t m_key;
+
+  /// Sums of middlegame and endgame piece-square values of all pieces, from
+  /// white's perspective. Updated incrementally as pieces are put and removed.
+  int m_score_mg;
+  int m_score_eg;
+
+  /// Sum of phase weights of all pieces, `MAX_PHASE` with starting material.
+  int m_phase;
 
   /**
    * Helper function for copy constructor and operator=.
@@ -251,6 +483,70 @@ private:
    * Helper function for destructor and operator=.
    */
   void destroy();
+
+  /**
+   * Constructs a piece object in the next free slot of the piece pool.
+   *
+   * @param type Type of piece.
+   * @param color Color of piece.
+   * @param coordinate Location of piece on board.
+   * @param moved Boolean if piece has moved on board.
+   * @return Pointer to constructed piece, not yet placed on board.
+   */
+  Piece *new_piece(const Piece::Type type, const Piece::Color color,
+                   const Coordinate &coordinate, const bool moved = false);
+
+  /**
+   * Reconstructs a piece object in place as another type, keeping its color,
+   * coordinate and moved flag. Used to promote pawns and to undo promotions.
+   *
+   * @param piece Piece to replace, not on board.
+   * @param type Type of replacement piece.
+   * @return Pointer to replacement piece.
+   */
+  Piece *replace_piece(Piece *piece, const Piece::Type type);
+
+  /**
+   * Computes the Zobrist key of the current position from scratch.
+   *
+   * @return Zobrist key of board.
+   */
+  uint64_t compute_key() const;
+
+  /**
+   * Determines if an em passant capture leaves the own king safe. Both pawns
+   * leave their squares, which can uncover an attack along the king's rank
+   * that pin masks do not catch.
+   *
+   * @param move Em passant move to test.
+   * @return Boolean value if `move` is legal.
+   */
+  bool empassant_legal(const Move &move) const;
+
+  /**
+   * Zobrist key contribution of the em passant target. Only counted if a
+   * pawn of the color to move can capture on the target.
+   *
+   * @return Em passant key of target file, 0 if no capturable target.
+   */
+  uint64_t empassant_key() const;
+
+  /**
+   * Places a piece object on its coordinate and sets its bitboards, key and
+   * evaluation terms.
+   *
+   * @param piece Piece to place, square must be empty.
+   */
+  void put_piece(Piece *piece);
+
+  /**
+   * Removes the piece on a square from the board and clears its bitboards, key
+   * and evaluation terms. The piece object is not destroyed.
+   *
+   * @param square Square index of piece to remove.
+   * @return Pointer to removed piece.
+   */
+  Piece *remove_piece(const int square);
 };
 
 #endif
\ No newline at end of file
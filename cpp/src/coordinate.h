@@ -1,10 +1,11 @@
 #ifndef COORDINATE_H
 #define COORDINATE_H
 
+#include <cstdint>
 #include <iostream>
 
 /**
- * Coordinate class.
+ * Coordinate class. Trivially copyable, two bytes.
  */
 class Coordinate {
 public:
@@ -21,16 +22,6 @@ public:
    */
   Coordinate(int rank, int file) : m_rank(rank), m_file(file){};
 
-  /**
-   * Constructs copy of coordinate.
-   *
-   * @param c Coordinate to copy.
-   */
-  Coordinate(const Coordinate &c) {
-    m_rank = c.m_rank;
-    m_file = c.m_file;
-  }
-
   /**
    * Getter for `m_rank`.
    *
@@ -65,10 +56,10 @@ public:
 
 private:
   /// Vertical position of coordinate.
-  int m_rank;
+  int8_t m_rank;
 
   /// Horizontal position of coordinate.
-  int m_file;
+  int8_t m_file;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef EVALUATION_H
+#define EVALUATION_H
+
+/// Material value of each piece type in centipawns, indexed by type.
+const int PIECE_VALUES[6] = {100, 320, 330, 500, 900, 0};
+
+/// Game phase weight of each piece type, indexed by type.
+const int PHASE_WEIGHTS[6] = {0, 1, 1, 2, 4, 0};
+
+/// Game phase of the starting material, counted down to 0 as pieces are
+/// captured.
+const int MAX_PHASE = 24;
+
+/// Middlegame value of each piece on each square, indexed by color, type,
+/// square. Material plus piece-square bonus, negated for black.
+extern int piece_square_mg[2][6][64];
+
+/// Endgame value of each piece on each square, indexed by color, type, square.
+/// Material plus piece-square bonus, negated for black.
+extern int piece_square_eg[2][6][64];
+
+/**
+ * Fills the piece-square value tables. Must be called once at startup before
+ * any board is used.
+ */
+void init_evaluation();
+
+#endif
\ No newline at end of file
@@ -1,13 +1,159 @@
+#include "batch.h"
+#include "bench.h"
+#include "bitboard.h"
 #include "board.h"
 #include "coordinate.h"
+#include "evaluation.h"
+#include "mappedfile.h"
 #include "move.h"
+#include "perft.h"
+#include "pgn.h"
 #include "piece.h"
+#include "search.h"
+#include "tournament.h"
+#include "transposition.h"
+#include "uci.h"
 #include "util.h"
+#include "zobrist.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
-int main() {
+/**
+ * Parses the search budget of a tournament player.
+ *
+ * @param budget String of form depth[:nodes[:movetime]].
+ * @return Search budget, fields missing from `budget` left at their default.
+ */
+static MoveBudget parse_budget(const std::string &budget) {
+  MoveBudget result;
+  std::istringstream fields(budget);
+  std::string field;
+  if (std::getline(fields, field, ':') && !field.empty()) {
+    result.depth = std::max(1, std::atoi(field.c_str()));
+  }
+  if (std::getline(fields, field, ':') && !field.empty()) {
+    result.nodes = std::strtoull(field.c_str(), nullptr, 10);
+  }
+  if (std::getline(fields, field, ':') && !field.empty()) {
+    result.move_time = std::max(0, std::atoi(field.c_str()));
+  }
+  return result;
+}
+
+int main(int argc, char *argv[]) {
   srand(time(NULL));
+  init_bitboards();
+  init_zobrist();
+  init_evaluation();
+
+  std::string mode = argc > 1 ? argv[1] : "";
+
+  // perft <depth> [fen]: leaf node count below each root move.
+  if (mode == "perft") {
+    int depth = argc > 2 ? std::atoi(argv[2]) : 5;
+    Board board = argc > 3 ? Board(argv[3]) : Board();
+    perft_divide(board, depth, std::cout);
+    return 0;
+  }
+
+  // perft-suite [max depth]: reference positions with known counts.
+  if (mode == "perft-suite") {
+    return perft_suite(argc > 2 ? std::atoi(argv[2]) : 5, std::cout) ? 0 : 1;
+  }
+
+  // bench [max threads] [depth]: search time to depth at each thread count.
+  if (mode == "bench") {
+    bench(argc > 2 ? std::atoi(argv[2]) : 16,
+          argc > 3 ? std::atoi(argv[3]) : DEFAULT_DEPTH + 1, std::cout);
+    return 0;
+  }
+
+  // batch <file | -> [workers] [depth] [nodes] [movetime]: analyze every
+  // position of a FEN/EPD file, results on standard output.
+  if (mode == "batch" && argc > 2) {
+    std::ifstream file;
+    std::string path = argv[2];
+    if (path != "-") {
+      file.open(path);
+      if (!file) {
+        std::cerr << "cannot open " << path << std::endl;
+        return 1;
+      }
+    }
+    int workers = argc > 3 ? std::atoi(argv[3])
+                           : int(std::thread::hardware_concurrency());
+    analyze_batch(path == "-" ? std::cin : file, std::cout, std::cerr, workers,
+                  argc > 4 ? std::atoi(argv[4]) : DEFAULT_DEPTH,
+                  argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 0,
+                  argc > 6 ? std::atoi(argv[6]) : 0);
+    return 0;
+  }
+
+  // tournament <openings | - | startpos> [games] [workers] [budget a]
+  // [budget b]: games between two search budgets of the form
+  // depth[:nodes[:movetime]], PGN on standard output and summary on standard
+  // error.
+  if (mode == "tournament" && argc > 2) {
+    std::string path = argv[2];
+    std::vector<std::string> openings(1, std::string(Board::START_FEN));
+    if (path != "startpos") {
+      std::ifstream file;
+      if (path != "-") {
+        file.open(path);
+        if (!file) {
+          std::cerr << "cannot open " << path << std::endl;
+          return 1;
+        }
+      }
+      openings = read_openings(path == "-" ? std::cin : file, std::cerr);
+      if (openings.empty()) {
+        std::cerr << "no valid positions in " << path << std::endl;
+        return 1;
+      }
+    }
+    run_tournament(openings, parse_budget(argc > 5 ? argv[5] : ""),
+                   parse_budget(argc > 6 ? argv[6] : ""),
+                   argc > 3 ? std::atoi(argv[3]) : 2,
+                   argc > 4 ? std::atoi(argv[4])
+                            : int(std::thread::hardware_concurrency()),
+                   std::cout, std::cerr);
+    return 0;
+  }
+
+  // pgn <file> [workers] [san | uci]: replay every game of a PGN file, games
+  // written again on standard output in the given notation if set.
+  if (mode == "pgn" && argc > 2) {
+    MappedFile file;
+    if (!file.open(argv[2])) {
+      std::cerr << "cannot open " << argv[2] << std::endl;
+      return 1;
+    }
+    std::string notation = argc > 4 ? argv[4] : "";
+    replay_pgn(file.get_text(),
+               argc > 3 ? std::atoi(argv[3])
+                        : int(std::thread::hardware_concurrency()),
+               notation.empty() ? nullptr : &std::cout,
+               notation == "uci" ? MoveNotation::UCI : MoveNotation::SAN,
+               std::cerr);
+    return 0;
+  }
+
+  // [uci]: Universal Chess Interface on standard input and output, the
+  // default so GUIs can start the engine without arguments.
+  if (mode == "" || mode == "uci") {
+    uci_loop(std::cin, std::cout);
+    return 0;
+  }
+
+  // play [threads]: self-play from the start position.
+  int threads = argc > 2 ? std::atoi(argv[2]) : 1;
+  TranspositionTable table;
 
   Board board("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
   // Board board("r3k2r/pppppppp/8/8/8/8/PPPPPPPP/R3K2R w KQkq - 0 1");
@@ -21,7 +167,7 @@ int main() {
   Move move;
   while (true) {
     // White move
-    move = find_move(board, Piece::Color::WHITE);
+    move = find_move(board, Piece::Color::WHITE, table, DEFAULT_DEPTH, threads);
     board.piece_at(move.get_from())->move(move);
 
     std::cout << board << move << std::endl;
@@ -31,7 +177,7 @@ int main() {
     // }
 
     // Black move
-    move = find_move(board, Piece::Color::BLACK);
+    move = find_move(board, Piece::Color::BLACK, table, DEFAULT_DEPTH, threads);
     board.piece_at(move.get_from())->move(move);
 
     std::cout << board << move << std::endl;
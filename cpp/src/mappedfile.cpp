@@ -0,0 +1,43 @@
+#include "mappedfile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool MappedFile::open(const std::string &path) {
+  close();
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+  // An empty file cannot be mapped, but is read as empty text.
+  if (info.st_size > 0) {
+    void *data =
+        mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      return false;
+    }
+    // The file is read front to back, let the kernel read ahead.
+    madvise(data, size_t(info.st_size), MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(data);
+    m_size = size_t(info.st_size);
+  }
+  ::close(fd);
+  return true;
+}
+
+void MappedFile::close() {
+  if (m_data != nullptr) {
+    munmap(const_cast<char *>(m_data), m_size);
+  }
+  m_data = nullptr;
+  m_size = 0;
+}
\ No newline at end of file
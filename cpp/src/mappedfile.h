@@ -0,0 +1,57 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * Read-only memory mapping of a whole file, so large files are read without
+ * copying them into memory first. Unmapped when destroyed.
+ */
+class MappedFile {
+public:
+  /**
+   * Constructs mapping of no file.
+   */
+  MappedFile() : m_data(nullptr), m_size(0) {}
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /**
+   * Destructor, unmaps the file.
+   */
+  ~MappedFile() { close(); }
+
+  /**
+   * Maps a file, unmapping any file mapped before.
+   *
+   * @param path Path of file.
+   * @return Boolean value if the file was mapped.
+   */
+  bool open(const std::string &path);
+
+  /**
+   * Unmaps the file, if any.
+   */
+  void close();
+
+  /**
+   * Getter for the contents of the file.
+   *
+   * @return Contents of the mapped file, empty if none.
+   */
+  std::string_view get_text() const {
+    return std::string_view(m_data, m_size);
+  }
+
+private:
+  /// Start of mapping, nullptr if none.
+  const char *m_data;
+
+  /// Size of mapping in bytes.
+  size_t m_size;
+};
+
+#endif
\ No newline at end of file
@@ -1,12 +1,15 @@
 #ifndef MOVE_H
 #define MOVE_H
 
+#include "bitboard.h"
 #include "coordinate.h"
 
+#include <cstdint>
 #include <iostream>
 
 /**
- * Move class.
+ * Move class. Packed into 16 bits: origin square (6 bits), destination square
+ * (6 bits) and move type (4 bits).
  */
 class Move {
 public:
@@ -24,43 +27,56 @@ public:
   };
 
   /**
-   * Constructs move object with move {-1, -1} -> {-1, -1}, default type.
+   * Constructs empty move object, packed as 0 (a1 -> a1, default type).
    */
-  Move()
-      : m_from(Coordinate()), m_dest(Coordinate()),
-        m_move_type(MoveType::DEFAULT){};
+  Move() : m_data(0){};
 
   /**
    * Constructs move object with given from/dest and type.
    *
-   * @param from Coordinate for origin of move.
-   * @param dest Coordinate for destination of move.
+   * @param from Coordinate for origin of move, within the board.
+   * @param dest Coordinate for destination of move, within the board.
    * @param move_type Type of move.
    */
   Move(const Coordinate &from, const Coordinate &dest,
        const MoveType move_type = MoveType::DEFAULT)
-      : m_from(from), m_dest(dest), m_move_type(move_type){};
+      : m_data(uint16_t(to_square(from) | to_square(dest) << 6 |
+                        int(move_type) << 12)){};
 
   /**
-   * Getter for `m_from`.
+   * Constructs move object from its packed encoding.
+   *
+   * @param data Packed move, as returned by `get_data`.
+   */
+  explicit Move(const uint16_t data) : m_data(data){};
+
+  /**
+   * Getter for origin of move.
    *
    * @return Origin of move.
    */
-  Coordinate get_from() const { return m_from; }
+  Coordinate get_from() const { return to_coordinate(m_data & 0x3F); }
 
   /**
-   * Getter for `m_dest`.
+   * Getter for destination of move.
    *
    * @return Destination of move.
    */
-  Coordinate get_dest() const { return m_dest; }
+  Coordinate get_dest() const { return to_coordinate((m_data >> 6) & 0x3F); }
 
   /**
-   * Getter for `m_move_type`.
+   * Getter for type of move.
    *
    * @return Type of move.
    */
-  MoveType get_type() const { return m_move_type; }
+  MoveType get_type() const { return MoveType(m_data >> 12); }
+
+  /**
+   * Getter for `m_data`.
+   *
+   * @return Packed move, 0 for the empty move.
+   */
+  uint16_t get_data() const { return m_data; }
 
   /**
    * Overload equality operator for move object.
@@ -69,7 +85,9 @@ public:
    * @param m2 Move 2.
    * @return Boolean if origin and destination of both moves are both equal.
    */
-  friend bool operator==(const Move &m1, const Move &m2);
+  friend bool operator==(const Move &m1, const Move &m2) {
+    return ((m1.m_data ^ m2.m_data) & 0xFFF) == 0;
+  }
 
   /**
    * Overload insertion operator for move object.
@@ -81,15 +99,13 @@ public:
   friend std::ostream &operator<<(std::ostream &os, const Move &m);
 
 private:
-  /// Origin of move
-  Coordinate m_from;
-
-  // Destination of move
-  Coordinate m_dest;
-
-  // Type of move (e.g. DEFAULT, QUEEN_CASTLE, KING_CASTLE, EM_PASSANT, DOUBLE,
-  // KNIGHT_PROMOTION, BISHOP_PROMOTION, ROOK_PROMOTION, QUEEN_PROMOTION)
-  MoveType m_move_type;
+  /// Origin square (bits 0-5), destination square (bits 6-11) and type of
+  /// move (bits 12-15, e.g. DEFAULT, QUEEN_CASTLE, KING_CASTLE, EM_PASSANT,
+  /// DOUBLE, KNIGHT_PROMOTION, BISHOP_PROMOTION, ROOK_PROMOTION,
+  /// QUEEN_PROMOTION)
+  uint16_t m_data;
 };
 
+static_assert(sizeof(Move) == 2, "Move must pack into 16 bits");
+
 #endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef MOVELIST_H
+#define MOVELIST_H
+
+#include "move.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/**
+ * Fixed capacity list of moves stored inline, so it can live on the stack
+ * during move generation without any heap allocation. Moves are only
+ * appended, storage past the current size is left uninitialized.
+ */
+class MoveList {
+public:
+  /// Maximum number of moves, above the 218 legal moves of any position.
+  static const size_t CAPACITY = 256;
+
+  /**
+   * Constructs an empty move list.
+   */
+  MoveList() : m_size(0) {}
+
+  /**
+   * Appends a move to the end of the list.
+   *
+   * @param move Move to append.
+   */
+  void push_back(const Move &move) { new (&m_moves[m_size++]) Move(move); }
+
+  /**
+   * Getter for `m_size`.
+   *
+   * @return Number of moves in list.
+   */
+  size_t size() const { return m_size; }
+
+  /**
+   * Determines if the list contains no moves.
+   *
+   * @return Boolean value if list is empty.
+   */
+  bool empty() const { return m_size == 0; }
+
+  /**
+   * Accesses a move of the list.
+   *
+   * @param index Index of move, less than `size()`.
+   * @return Reference to move at `index`.
+   */
+  Move &operator[](const size_t index) { return begin()[index]; }
+  const Move &operator[](const size_t index) const { return begin()[index]; }
+
+  /**
+   * Iterators over the moves of the list.
+   */
+  Move *begin() { return reinterpret_cast<Move *>(m_moves); }
+  Move *end() { return begin() + m_size; }
+  const Move *begin() const { return reinterpret_cast<const Move *>(m_moves); }
+  const Move *end() const { return begin() + m_size; }
+
+private:
+  /// Uninitialized storage of moves.
+  typename std::aligned_storage<sizeof(Move), alignof(Move)>::type
+      m_moves[CAPACITY];
+
+  /// Number of moves in list.
+  size_t m_size;
+};
+
+static_assert(std::is_trivially_destructible<Move>::value,
+              "MoveList never destroys its moves");
+
+#endif
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include "movepicker.h"
+
+#include "bitboard.h"
+
+#include <algorithm>
+
+MovePicker::MovePicker(const Board &b, const Piece::Color color,
+                       const Move &hash_move, const Move *killers,
+                       const int (*history)[64])
+    : m_board(b), m_color(color), m_info(b.check_info(color)),
+      m_stage(Stage::HASH_MOVE), m_captures_only(false),
+      m_hash_move(hash_move), m_history(history), m_capture_index(0),
+      m_bad_capture_index(0), m_quiet_index(0), m_killer_index(0) {
+  Coordinate empassant_target = b.get_empassant_target();
+  m_empassant = b.contains(empassant_target)
+                    ? square_bb(to_square(empassant_target))
+                    : 0;
+  for (int i = 0; i < KILLERS; ++i) {
+    m_killers[i] = killers != nullptr ? killers[i] : Move();
+  }
+  if (!(m_hash_move == Move()) && !hash_move_valid()) {
+    m_hash_move = Move();
+  }
+}
+
+MovePicker::MovePicker(const Board &b, const Piece::Color color)
+    : MovePicker(b, color, Move(), nullptr, nullptr) {
+  m_stage = Stage::GENERATE_CAPTURES;
+  m_captures_only = true;
+}
+
+bool MovePicker::next(Move &move) {
+  switch (m_stage) {
+  case Stage::HASH_MOVE:
+    m_stage = Stage::GENERATE_CAPTURES;
+    if (!(m_hash_move == Move())) {
+      move = m_hash_move;
+      return true;
+    }
+    // fall through
+  case Stage::GENERATE_CAPTURES: {
+    // Em passant moves land on the empty target square, so it is generated
+    // with the captures along with any other move onto it.
+    Piece::Color opposite_color = (m_color == Piece::Color::WHITE)
+                                      ? Piece::Color::BLACK
+                                      : Piece::Color::WHITE;
+    m_board.get_moves(m_color, m_captures, m_info,
+                      m_board.occupancy(opposite_color) | m_empassant);
+
+    // Most valuable victim / least valuable attacker (MVV-LVA). Piece types
+    // are declared from least to most valuable.
+    for (size_t i = 0; i < m_captures.size(); ++i) {
+      const Move &capture = m_captures[i];
+      const Piece *victim = m_board.piece_at(capture.get_dest());
+      int victim_type = victim != nullptr ? int(victim->get_type())
+                                          : int(Piece::Type::PAWN);
+      m_capture_scores[i] =
+          victim_type * 8 -
+          int(m_board.piece_at(capture.get_from())->get_type());
+    }
+    m_stage = Stage::GOOD_CAPTURES;
+  }
+    // fall through
+  case Stage::GOOD_CAPTURES:
+    while (m_capture_index < m_captures.size()) {
+      move = pick_best(m_captures, m_capture_scores, m_capture_index);
+      if (picked_early(move)) {
+        continue;
+      }
+      if (m_board.see(move) < 0) {
+        if (!m_captures_only) {
+          m_bad_captures.push_back(move);
+        }
+        continue;
+      }
+      return true;
+    }
+    if (m_captures_only) {
+      m_stage = Stage::DONE;
+      return false;
+    }
+    m_stage = Stage::GENERATE_QUIETS;
+    // fall through
+  case Stage::GENERATE_QUIETS:
+    m_board.get_moves(m_color, m_quiets, m_info,
+                      ~(m_board.occupancy() | m_empassant));
+    for (size_t i = 0; i < m_quiets.size(); ++i) {
+      m_quiet_scores[i] = m_history[to_square(m_quiets[i].get_from())]
+                                   [to_square(m_quiets[i].get_dest())];
+    }
+    m_stage = Stage::KILLERS;
+    // fall through
+  case Stage::KILLERS:
+    // A killer move is only picked if it is a quiet move of this position.
+    while (m_killer_index < KILLERS) {
+      Move &killer = m_killers[m_killer_index++];
+      if (killer == Move() || killer.get_data() == m_hash_move.get_data() ||
+          std::none_of(m_quiets.begin(), m_quiets.end(),
+                       [&killer](const Move &quiet) {
+                         return quiet.get_data() == killer.get_data();
+                       })) {
+        killer = Move();
+        continue;
+      }
+      move = killer;
+      return true;
+    }
+    m_stage = Stage::QUIETS;
+    // fall through
+  case Stage::QUIETS:
+    while (m_quiet_index < m_quiets.size()) {
+      move = pick_best(m_quiets, m_quiet_scores, m_quiet_index);
+      if (!picked_early(move)) {
+        return true;
+      }
+    }
+    m_stage = Stage::BAD_CAPTURES;
+    // fall through
+  case Stage::BAD_CAPTURES:
+    if (m_bad_capture_index < m_bad_captures.size()) {
+      move = m_bad_captures[m_bad_capture_index++];
+      return true;
+    }
+    m_stage = Stage::DONE;
+    // fall through
+  case Stage::DONE:
+    break;
+  }
+  return false;
+}
+
+bool MovePicker::hash_move_valid() const {
+  const Piece *piece = m_board.piece_at(m_hash_move.get_from());
+  if (piece == nullptr || piece->get_color() != m_color) {
+    return false;
+  }
+
+  // Generate the moves of the piece onto the destination only.
+  MoveList moves;
+  piece->get_moves(moves, m_info,
+                   square_bb(to_square(m_hash_move.get_dest())));
+  return std::any_of(moves.begin(), moves.end(), [this](const Move &move) {
+    return move.get_data() == m_hash_move.get_data();
+  });
+}
+
+bool MovePicker::picked_early(const Move &move) const {
+  // Compare whole moves, promotions to different pieces share squares.
+  if (move.get_data() == m_hash_move.get_data()) {
+    return true;
+  }
+  for (int i = 0; i < m_killer_index; ++i) {
+    if (move.get_data() == m_killers[i].get_data()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Move MovePicker::pick_best(MoveList &moves, int *scores, size_t &index) {
+  size_t best = index;
+  for (size_t i = index + 1; i < moves.size(); ++i) {
+    if (scores[i] > scores[best]) {
+      best = i;
+    }
+  }
+  std::swap(moves[index], moves[best]);
+  std::swap(scores[index], scores[best]);
+  return moves[index++];
+}
\ No newline at end of file
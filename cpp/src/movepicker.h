@@ -0,0 +1,141 @@
+#ifndef MOVEPICKER_H
+#define MOVEPICKER_H
+
+#include "board.h"
+#include "move.h"
+#include "movelist.h"
+#include "piece.h"
+
+/**
+ * Yields the valid moves of a position one at a time in search order: the
+ * hash move, captures that do not lose material, killer moves, quiet moves by
+ * history, then captures that lose material. Each group is only generated
+ * once reached, so a cutoff on an early move skips generating the rest.
+ */
+class MovePicker {
+public:
+  /// Number of killer moves kept per ply.
+  static const int KILLERS = 2;
+
+  /**
+   * Constructs move picker of a position.
+   *
+   * @param b Board to pick moves on, must be in the same position whenever
+   * `next` is called.
+   * @param color Color to pick moves of.
+   * @param hash_move Best move stored for the position, empty move if none.
+   * Skipped if not valid.
+   * @param killers `KILLERS` quiet moves that caused a cutoff at the same ply,
+   * nullptr if none. Skipped if not valid.
+   * @param history Ordering value of quiet moves of `color`, indexed by
+   * origin and destination square.
+   */
+  MovePicker(const Board &b, const Piece::Color color, const Move &hash_move,
+             const Move *killers, const int (*history)[64]);
+
+  /**
+   * Constructs move picker of only the captures of a position that do not
+   * lose material, for quiescence search.
+   *
+   * @param b Board to pick moves on, must be in the same position whenever
+   * `next` is called.
+   * @param color Color to pick moves of.
+   */
+  MovePicker(const Board &b, const Piece::Color color);
+
+  /**
+   * Obtains the next move in search order.
+   *
+   * @param move Set to the next move.
+   * @return Boolean value if a move was left, false once every valid move has
+   * been picked.
+   */
+  bool next(Move &move);
+
+private:
+  /// Groups of moves, picked in order of declaration.
+  enum class Stage {
+    HASH_MOVE,
+    GENERATE_CAPTURES,
+    GOOD_CAPTURES,
+    GENERATE_QUIETS,
+    KILLERS,
+    QUIETS,
+    BAD_CAPTURES,
+    DONE
+  };
+
+  /// Board to pick moves on.
+  const Board &m_board;
+
+  /// Color to pick moves of.
+  Piece::Color m_color;
+
+  /// Legality masks of `m_color`, shared by every generated group.
+  CheckInfo m_info;
+
+  /// Bitboard of em passant target, empty if none.
+  Bitboard m_empassant;
+
+  /// Current group of moves.
+  Stage m_stage;
+
+  /// True if only captures that do not lose material are picked.
+  bool m_captures_only;
+
+  /// Hash move, empty move if none or not valid.
+  Move m_hash_move;
+
+  /// Killer moves, each set to the empty move unless picked.
+  Move m_killers[KILLERS];
+
+  /// Ordering value of quiet moves, indexed by origin and destination square.
+  const int (*m_history)[64];
+
+  /// Captures and their ordering values, picked from `m_capture_index` on.
+  MoveList m_captures;
+  int m_capture_scores[MoveList::CAPACITY];
+  size_t m_capture_index;
+
+  /// Captures losing material, put aside until quiet moves are picked.
+  MoveList m_bad_captures;
+  size_t m_bad_capture_index;
+
+  /// Quiet moves and their ordering values, picked from `m_quiet_index` on.
+  MoveList m_quiets;
+  int m_quiet_scores[MoveList::CAPACITY];
+  size_t m_quiet_index;
+
+  /// Index of next killer move to try.
+  int m_killer_index;
+
+  /**
+   * Determines if the hash move is a valid move of the position, since it
+   * may come from a different position stored under the same key.
+   *
+   * @return Boolean value if `m_hash_move` is valid.
+   */
+  bool hash_move_valid() const;
+
+  /**
+   * Determines if a move has already been picked as hash or killer move.
+   *
+   * @param move Move to check.
+   * @return Boolean value if `move` was picked ahead of its group.
+   */
+  bool picked_early(const Move &move) const;
+
+  /**
+   * Picks the move with the highest ordering value from the unpicked part of
+   * a list, moving it to the front of that part (selection sort, one move at
+   * a time).
+   *
+   * @param moves List of moves.
+   * @param scores Ordering values of `moves`.
+   * @param index Index of first unpicked move, incremented.
+   * @return Move picked.
+   */
+  static Move pick_best(MoveList &moves, int *scores, size_t &index);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "perft.h"
+
+#include <algorithm>
+#include <chrono>
+
+/**
+ * Reference position with known perft counts.
+ */
+struct PerftPosition {
+  /// Name of position.
+  const char *name;
+
+  /// Layout of position.
+  const char *fen;
+
+  /// Deepest depth run by default.
+  int depth;
+
+  /// Leaf node counts at depths 1 to 5.
+  uint64_t nodes[5];
+};
+
+/// Standard perft positions (https://www.chessprogramming.org/Perft_Results).
+static const PerftPosition PERFT_POSITIONS[] = {
+    {"start position",
+     "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+     5,
+     {20, 400, 8902, 197281, 4865609}},
+    {"kiwipete",
+     "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+     4,
+     {48, 2039, 97862, 4085603, 193690690}},
+    {"position 3",
+     "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+     5,
+     {14, 191, 2812, 43238, 674624}},
+    {"position 4",
+     "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+     4,
+     {6, 264, 9467, 422333, 15833292}},
+    {"position 5",
+     "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+     4,
+     {44, 1486, 62379, 2103487, 89941194}},
+    {"position 6",
+     "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 "
+     "10",
+     4,
+     {46, 2079, 89890, 3894594, 164075551}}};
+
+/**
+ * Position that must be rejected before any move is generated from it.
+ */
+struct InvalidPosition {
+  /// Layout of position.
+  const char *fen;
+
+  /// Reason `fen` is rejected.
+  FenError error;
+};
+
+/// Positions whose moves would be generated from an inconsistent board.
+static const InvalidPosition INVALID_POSITIONS[] = {
+    // No pawn in front of the em passant target.
+    {"4k3/8/8/3P4/8/8/8/4K3 w - e6 0 1", FenError::EM_PASSANT_TARGET},
+    // Target occupied.
+    {"4k3/8/4n3/3Pp3/8/8/8/4K3 w - e6 0 1", FenError::EM_PASSANT_TARGET},
+    // Square the pawn came from occupied.
+    {"4k3/4n3/8/3Pp3/8/8/8/4K3 w - e6 0 1", FenError::EM_PASSANT_TARGET},
+    // Pawn in front of the target is of the color to move.
+    {"4k3/8/8/8/3pP3/8/8/4K3 b - d3 0 1", FenError::EM_PASSANT_TARGET}};
+
+uint64_t perft(Board &b, int depth) {
+  if (depth <= 0) {
+    return 1;
+  }
+
+  MoveList moves;
+  b.get_moves(b.get_current_move(), moves);
+
+  // Count moves directly at the last ply instead of playing them.
+  if (depth == 1) {
+    return moves.size();
+  }
+
+  uint64_t nodes = 0;
+  for (const Move &move : moves) {
+    b.piece_at(move.get_from())->move(move);
+    nodes += perft(b, depth - 1);
+    b.unmake_move();
+  }
+  return nodes;
+}
+
+uint64_t perft_divide(Board &b, int depth, std::ostream &os) {
+  auto start = std::chrono::steady_clock::now();
+
+  // Only the current position is counted below depth 1.
+  uint64_t nodes = depth <= 0 ? 1 : 0;
+  MoveList moves;
+  if (depth > 0) {
+    b.get_moves(b.get_current_move(), moves);
+  }
+  for (const Move &move : moves) {
+    b.piece_at(move.get_from())->move(move);
+    uint64_t move_nodes = perft(b, depth - 1);
+    b.unmake_move();
+    nodes += move_nodes;
+    os << move << ": " << move_nodes << std::endl;
+  }
+
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  os << std::endl << "Nodes searched: " << nodes << std::endl;
+  os << "Time: " << seconds << "s, "
+     << uint64_t(seconds > 0 ? nodes / seconds : 0) << " nodes/s"
+     << std::endl;
+  return nodes;
+}
+
+bool perft_suite(int max_depth, std::ostream &os) {
+  bool passed = true;
+  uint64_t total_nodes = 0;
+  double total_seconds = 0;
+
+  for (const PerftPosition &position : PERFT_POSITIONS) {
+    Board b(position.fen);
+    int depth = std::max(1, std::min(position.depth, max_depth));
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t nodes = perft(b, depth);
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+    bool match = nodes == position.nodes[depth - 1];
+    passed = passed && match;
+    total_nodes += nodes;
+    total_seconds += seconds;
+
+    os << position.name << " depth " << depth << ": " << nodes;
+    if (!match) {
+      os << " FAILED, expected " << position.nodes[depth - 1];
+    }
+    os << " (" << uint64_t(seconds > 0 ? nodes / seconds : 0) << " nodes/s)"
+       << std::endl;
+  }
+
+  for (const InvalidPosition &position : INVALID_POSITIONS) {
+    Board b;
+    FenError error = b.set_fen(position.fen);
+    if (error != position.error) {
+      passed = false;
+      os << "FEN " << position.fen << " FAILED, expected rejection"
+         << std::endl;
+    }
+  }
+
+  os << "Total: " << total_nodes << " nodes in " << total_seconds << "s, "
+     << uint64_t(total_seconds > 0 ? total_nodes / total_seconds : 0)
+     << " nodes/s" << std::endl;
+  return passed;
+}
\ No newline at end of file
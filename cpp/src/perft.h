@@ -0,0 +1,41 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+#include "board.h"
+
+#include <cstdint>
+#include <iostream>
+
+/**
+ * Counts the leaf nodes of the legal move tree from the current board state.
+ * Moves are generated with `Board::get_moves` and played with `Piece::move`.
+ *
+ * @param b Board to count from, left unchanged.
+ * @param depth Number of plies to search.
+ * @return Number of leaf nodes at `depth`, 1 if `depth` is not positive.
+ */
+uint64_t perft(Board &b, int depth);
+
+/**
+ * Runs perft and outputs the leaf node count below each root move, followed
+ * by the total, time and nodes per second.
+ *
+ * @param b Board to count from, left unchanged.
+ * @param depth Number of plies to search.
+ * @param os Stream to output to.
+ * @return Number of leaf nodes at `depth`, 1 if `depth` is not positive.
+ */
+uint64_t perft_divide(Board &b, int depth, std::ostream &os);
+
+/**
+ * Runs perft on the standard reference positions and compares each count
+ * with its known value, then checks that malformed positions are rejected.
+ *
+ * @param max_depth Maximum depth to search each position to (1 to 5).
+ * @param os Stream to output results and nodes per second to.
+ * @return Boolean value if every count matches and every malformed position
+ * is rejected.
+ */
+bool perft_suite(int max_depth, std::ostream &os);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,563 @@
+#include "pgn.h"
+
+#include "bitboard.h"
+#include "movelist.h"
+#include "util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+/// Piece letters of SAN, indexed by piece type. Pawns have none.
+static const char SAN_PIECE_CHARS[] = " NBRQK";
+
+/// Column lines of movetext are wrapped before.
+static const size_t PGN_LINE_LENGTH = 80;
+
+/**
+ * Appends the name of a square (e.g. "e4") to a string.
+ *
+ * @param str String to append to.
+ * @param coordinate Coordinate of square.
+ */
+static void append_square(std::string &str, const Coordinate &coordinate) {
+  str += char('a' + coordinate.get_file());
+  str += char('1' + coordinate.get_rank());
+}
+
+/**
+ * Converts a valid move into SAN without its check or checkmate suffix.
+ *
+ * @param b Board move is played on, before the move.
+ * @param move Move to convert, valid on `b`.
+ * @return SAN string of `move` without suffix.
+ */
+static std::string san_without_suffix(const Board &b, const Move &move) {
+  std::string san;
+  const Piece *piece = b.piece_at(move.get_from());
+  Piece::Type type = piece->get_type();
+  Coordinate from = move.get_from(), dest = move.get_dest();
+  bool capture = b.piece_at(dest) != nullptr ||
+                 move.get_type() == Move::MoveType::EM_PASSANT;
+
+  if (move.get_type() == Move::MoveType::KING_CASTLE) {
+    san = "O-O";
+  } else if (move.get_type() == Move::MoveType::QUEEN_CASTLE) {
+    san = "O-O-O";
+  } else if (type == Piece::Type::PAWN) {
+    // Pawn captures name the origin file instead of a piece.
+    if (capture) {
+      san += char('a' + from.get_file());
+      san += 'x';
+    }
+    append_square(san, dest);
+    if (move.get_type() >= Move::MoveType::KNIGHT_PROMOTION) {
+      san += '=';
+      san += SAN_PIECE_CHARS[int(move.get_type()) -
+                             int(Move::MoveType::KNIGHT_PROMOTION) + 1];
+    }
+  } else {
+    san += SAN_PIECE_CHARS[int(type)];
+
+    // Name the origin file if it tells the pieces reaching the destination
+    // apart, otherwise the rank, otherwise both.
+    Piece::Color color = piece->get_color();
+    MoveList moves;
+    b.get_moves(color, moves, b.check_info(color), square_bb(to_square(dest)));
+    bool ambiguous = false, same_file = false, same_rank = false;
+    for (const Move &other : moves) {
+      if (!(other.get_from() == from) &&
+          b.piece_at(other.get_from())->get_type() == type) {
+        ambiguous = true;
+        same_file |= other.get_from().get_file() == from.get_file();
+        same_rank |= other.get_from().get_rank() == from.get_rank();
+      }
+    }
+    if (ambiguous && (!same_file || same_rank)) {
+      san += char('a' + from.get_file());
+    }
+    if (ambiguous && same_file) {
+      san += char('1' + from.get_rank());
+    }
+    if (capture) {
+      san += 'x';
+    }
+    append_square(san, dest);
+  }
+  return san;
+}
+
+/**
+ * Obtains the SAN suffix of the position after a move.
+ *
+ * @param after Board after the move.
+ * @return "#" if the color to move is checkmated, "+" if in check, otherwise
+ * empty.
+ */
+static const char *san_suffix(const Board &after) {
+  Piece::Color color = after.get_current_move();
+  if (!after.in_check(color)) {
+    return "";
+  }
+  return after.has_moves(color) ? "+" : "#";
+}
+
+std::string move_to_san(const Board &b, const Move &move) {
+  Board after(b);
+  after.make_move(move);
+  return san_without_suffix(b, move) + san_suffix(after);
+}
+
+std::ostream &write_pgn(std::ostream &os, const PgnGame &game,
+                        const MoveNotation notation) {
+  std::string_view fen = Board::START_FEN;
+  for (const auto &tag : game.tags) {
+    os << '[' << tag.first << " \"";
+    for (char c : tag.second) {
+      if (c == '"' || c == '\\') {
+        os << '\\';
+      }
+      os << c;
+    }
+    os << "\"]\n";
+    if (tag.first == "FEN") {
+      fen = tag.second;
+    }
+  }
+  os << '\n';
+
+  // Movetext, black moves only get a number if they start a line of play.
+  // Moves are played on one board, check suffixes are found after playing.
+  Board board(fen);
+  std::string line;
+  auto add_token = [&os, &line](const std::string &token) {
+    if (!line.empty() && line.size() + 1 + token.size() >= PGN_LINE_LENGTH) {
+      os << line << '\n';
+      line.clear();
+    }
+    line += (line.empty() ? "" : " ") + token;
+  };
+  for (size_t i = 0; i < game.moves.size(); ++i) {
+    if (board.get_current_move() == Piece::Color::WHITE) {
+      add_token(std::to_string(board.get_fullmove_number()) + ".");
+    } else if (i == 0) {
+      add_token(std::to_string(board.get_fullmove_number()) + "...");
+    }
+    if (notation == MoveNotation::UCI) {
+      board.make_move(game.moves[i]);
+      add_token(move_to_uci(game.moves[i]));
+    } else {
+      std::string san = san_without_suffix(board, game.moves[i]);
+      board.make_move(game.moves[i]);
+      add_token(san + san_suffix(board));
+    }
+  }
+  add_token(game.result);
+  return os << line << "\n\n";
+}
+
+/**
+ * Determines if a character separates tokens of movetext.
+ *
+ * @param c Character to check.
+ * @return Boolean value if `c` is whitespace.
+ */
+static bool is_space(const char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' ||
+         c == '\v';
+}
+
+/**
+ * Determines if a character ends a move or move number token.
+ *
+ * @param c Character to check.
+ * @return Boolean value if `c` is whitespace or starts a comment, variation
+ * or glyph.
+ */
+static bool ends_token(const char c) {
+  return is_space(c) || c == '{' || c == '}' || c == '(' || c == ')' ||
+         c == ';' || c == '$' || c == '[' || c == ']';
+}
+
+/**
+ * Determines if an offset of PGN text is at the start of a line.
+ *
+ * @param text PGN text.
+ * @param position Offset in `text`.
+ * @return Boolean value if `position` starts a line.
+ */
+static bool line_start(const std::string_view text, const size_t position) {
+  return position == 0 || text[position - 1] == '\n';
+}
+
+/**
+ * Obtains the piece type of a SAN piece letter.
+ *
+ * @param c Piece letter, upper or lower case.
+ * @param type Set to piece type of `c`.
+ * @return Boolean value if `c` is a piece letter other than king.
+ */
+static bool promotion_type(const char c, Piece::Type &type) {
+  switch (c) {
+  case 'N':
+  case 'n':
+    type = Piece::Type::KNIGHT;
+    return true;
+  case 'B':
+  case 'b':
+    type = Piece::Type::BISHOP;
+    return true;
+  case 'R':
+  case 'r':
+    type = Piece::Type::ROOK;
+    return true;
+  case 'Q':
+  case 'q':
+    type = Piece::Type::QUEEN;
+    return true;
+  default:
+    return false;
+  }
+}
+
+PgnReader::PgnReader(const std::string_view text)
+    : m_text(text), m_position(0), m_errors(0) {}
+
+void PgnReader::skip_separators() {
+  int variation_depth = 0;
+  while (m_position < m_text.size()) {
+    char c = m_text[m_position];
+    if (is_space(c)) {
+      ++m_position;
+    } else if (c == '{') {
+      // Comments do not nest and end at the first closing brace.
+      size_t end = m_text.find('}', m_position);
+      m_position = end == std::string_view::npos ? m_text.size() : end + 1;
+    } else if (c == ';' || (c == '%' && line_start(m_text, m_position))) {
+      // Rest of line comments and escape lines.
+      size_t end = m_text.find('\n', m_position);
+      m_position = end == std::string_view::npos ? m_text.size() : end + 1;
+    } else if (c == '(') {
+      ++variation_depth;
+      ++m_position;
+    } else if (c == ')' && variation_depth > 0) {
+      --variation_depth;
+      ++m_position;
+    } else if (variation_depth > 0 || c == '$') {
+      // Moves of variations and numeric annotation glyphs.
+      ++m_position;
+      while (m_position < m_text.size() && !ends_token(m_text[m_position])) {
+        ++m_position;
+      }
+    } else {
+      return;
+    }
+  }
+}
+
+void PgnReader::read_tag(PgnGame &game, size_t &tag_count) {
+  if (tag_count == game.tags.size()) {
+    game.tags.emplace_back();
+  }
+  auto &tag = game.tags[tag_count++];
+
+  // Tag name up to whitespace, then the value between quotes with '\'
+  // escaping '"' and '\'.
+  size_t start = ++m_position;
+  while (m_position < m_text.size() && !is_space(m_text[m_position]) &&
+         m_text[m_position] != '"' && m_text[m_position] != ']') {
+    ++m_position;
+  }
+  tag.first.assign(m_text.substr(start, m_position - start));
+  tag.second.clear();
+  m_position = std::min(m_text.find('"', m_position), m_text.size());
+  size_t end = std::min(m_text.find('\n', m_position), m_text.size());
+  for (++m_position; m_position < end && m_text[m_position] != '"';
+       ++m_position) {
+    if (m_text[m_position] == '\\' && m_position + 1 < end) {
+      ++m_position;
+    }
+    tag.second += m_text[m_position];
+  }
+
+  // Rest of the line, normally the closing bracket.
+  m_position = std::min(end + 1, m_text.size());
+}
+
+bool PgnReader::next(PgnGame &game) {
+  while (true) {
+    skip_separators();
+    if (m_position >= m_text.size()) {
+      return false;
+    }
+
+    size_t tag_count = 0;
+    while (m_position < m_text.size() && m_text[m_position] == '[') {
+      read_tag(game, tag_count);
+      skip_separators();
+    }
+    game.tags.resize(tag_count);
+
+    if (read_movetext(game)) {
+      return true;
+    }
+    ++m_errors;
+  }
+}
+
+bool PgnReader::read_movetext(PgnGame &game) {
+  game.moves.clear();
+  game.result = "*";
+  std::string_view fen = Board::START_FEN;
+  for (const auto &tag : game.tags) {
+    if (tag.first == "FEN") {
+      fen = tag.second;
+    }
+  }
+  bool valid = m_board.set_fen(fen) == FenError::NONE;
+
+  // Tokens up to the result, or up to the tags of the next game if the
+  // result is missing. Once a move is not valid, the rest of the game is
+  // skipped.
+  while (true) {
+    skip_separators();
+    if (m_position >= m_text.size() ||
+        (m_text[m_position] == '[' && line_start(m_text, m_position))) {
+      return valid;
+    }
+    size_t start = m_position;
+    while (m_position < m_text.size() && !ends_token(m_text[m_position])) {
+      ++m_position;
+    }
+    std::string_view token = m_text.substr(start, m_position - start);
+    if (token.empty()) {
+      // Stray closing brace, parenthesis or bracket.
+      ++m_position;
+      continue;
+    }
+
+    if (token == "1-0" || token == "0-1" || token == "1/2-1/2" ||
+        token == "*") {
+      game.result.assign(token);
+      return valid;
+    }
+
+    // Move numbers, possibly followed by a move without a space ("1.e4").
+    if (token[0] >= '1' && token[0] <= '9') {
+      size_t number_end = token.find_first_not_of("0123456789");
+      if (number_end == std::string_view::npos) {
+        continue;
+      }
+      number_end = token.find_first_not_of('.', number_end);
+      if (number_end == std::string_view::npos) {
+        continue;
+      }
+      token.remove_prefix(number_end);
+    }
+
+    // Drop check, checkmate and annotation suffixes.
+    while (!token.empty() && (token.back() == '+' || token.back() == '#' ||
+                              token.back() == '!' || token.back() == '?')) {
+      token.remove_suffix(1);
+    }
+    if (!valid || token.empty()) {
+      continue;
+    }
+    Move move = resolve_move(token);
+    if (move == Move()) {
+      valid = false;
+      continue;
+    }
+    game.moves.push_back(move);
+    m_board.make_move(move);
+  }
+}
+
+Move PgnReader::resolve_move(const std::string_view token) {
+  Piece::Color color = m_board.get_current_move();
+  int back_rank = color == Piece::Color::WHITE ? 0 : Board::SIZE - 1;
+  Piece::Type type = Piece::Type::PAWN;
+  Move::MoveType castle = Move::MoveType::DEFAULT;
+  bool promotion = false;
+  Piece::Type promotion_piece = Piece::Type::QUEEN;
+  int from_file = -1, from_rank = -1, dest = -1;
+
+  if (token == "O-O" || token == "0-0") {
+    castle = Move::MoveType::KING_CASTLE;
+    dest = to_square(Coordinate(back_rank, 6));
+  } else if (token == "O-O-O" || token == "0-0-0") {
+    castle = Move::MoveType::QUEEN_CASTLE;
+    dest = to_square(Coordinate(back_rank, 2));
+  } else {
+    std::string_view rest = token;
+    if (rest[0] == 'N' || rest[0] == 'B' || rest[0] == 'R' || rest[0] == 'Q' ||
+        rest[0] == 'K') {
+      type = Piece::Type(std::string_view(SAN_PIECE_CHARS).find(rest[0]));
+      rest.remove_prefix(1);
+    }
+
+    // Promotion piece after the destination, "=Q" in SAN or "q" in UCI.
+    if (rest.size() >= 3 && promotion_type(rest.back(), promotion_piece) &&
+        (rest[rest.size() - 2] == '=' ||
+         (rest[rest.size() - 2] >= '1' && rest[rest.size() - 2] <= '8'))) {
+      promotion = true;
+      rest.remove_suffix(rest[rest.size() - 2] == '=' ? 2 : 1);
+    }
+
+    // Destination square, then any origin file and rank. Capture marks and
+    // the '-' of long algebraic notation are ignored.
+    if (rest.size() < 2 || rest[rest.size() - 2] < 'a' ||
+        rest[rest.size() - 2] > 'h' || rest.back() < '1' ||
+        rest.back() > '8') {
+      return Move();
+    }
+    dest = to_square(
+        Coordinate(rest.back() - '1', rest[rest.size() - 2] - 'a'));
+    rest.remove_suffix(2);
+    for (char c : rest) {
+      if (c >= 'a' && c <= 'h') {
+        from_file = c - 'a';
+      } else if (c >= '1' && c <= '8') {
+        from_rank = c - '1';
+      } else if (c != 'x' && c != ':' && c != '-') {
+        return Move();
+      }
+    }
+
+    // Moves in UCI notation have no piece letter, the piece is the one on
+    // the origin square.
+    const Piece *piece =
+        from_file >= 0 && from_rank >= 0
+            ? m_board.piece_at(Coordinate(from_rank, from_file))
+            : nullptr;
+    if (piece != nullptr) {
+      type = piece->get_type();
+    }
+  }
+
+  // Only moves onto the destination are generated, the move must be the only
+  // one matching every part of the token.
+  MoveList moves;
+  m_board.get_moves(color, moves, m_board.check_info(color), square_bb(dest));
+  Move match;
+  for (const Move &move : moves) {
+    Coordinate from = move.get_from();
+    bool is_promotion = move.get_type() >= Move::MoveType::KNIGHT_PROMOTION;
+    if (castle != Move::MoveType::DEFAULT) {
+      if (move.get_type() != castle) {
+        continue;
+      }
+    } else if (m_board.piece_at(from)->get_type() != type ||
+               (from_file >= 0 && from.get_file() != from_file) ||
+               (from_rank >= 0 && from.get_rank() != from_rank) ||
+               is_promotion != promotion ||
+               (promotion &&
+                int(move.get_type()) - int(Move::MoveType::KNIGHT_PROMOTION) !=
+                    int(promotion_piece) - int(Piece::Type::KNIGHT))) {
+      continue;
+    }
+    if (!(match == Move())) {
+      return Move();
+    }
+    match = move;
+  }
+  return match;
+}
+
+std::vector<std::string_view> split_pgn(const std::string_view text,
+                                        const int count) {
+  // Each shard boundary is moved forward to the next tag line following a
+  // blank line, where a game starts.
+  std::vector<std::string_view> shards;
+  size_t start = 0;
+  for (int i = 1; i <= count && start < text.size(); ++i) {
+    size_t end = i == count ? text.size() : text.size() / count * i;
+    end = std::max(end, start + 1);
+    while (end < text.size()) {
+      end = text.find("\n[", end);
+      if (end == std::string_view::npos) {
+        end = text.size();
+        break;
+      }
+      size_t line = text.rfind('\n', end - 1);
+      line = line == std::string_view::npos ? 0 : line + 1;
+      ++end;
+      if (text.find_first_not_of(" \t\r", line) >= end - 1) {
+        break;
+      }
+    }
+    shards.push_back(text.substr(start, end - start));
+    start = end;
+  }
+  return shards;
+}
+
+/**
+ * Counts of games replayed by one worker.
+ */
+struct ReplayCounts {
+  /// Number of games read.
+  size_t games = 0;
+
+  /// Number of moves played.
+  size_t moves = 0;
+
+  /// Number of games skipped for a move or FEN tag that is not valid.
+  size_t errors = 0;
+};
+
+/**
+ * Replays the games of one shard.
+ *
+ * @param shard PGN text of shard.
+ * @param out Stream to write games to again, nullptr for none.
+ * @param notation Notation of moves written to `out`.
+ * @param counts Set to counts of shard.
+ */
+static void replay_shard(const std::string_view shard, std::ostream *out,
+                         const MoveNotation notation, ReplayCounts *counts) {
+  PgnReader reader(shard);
+  PgnGame game;
+  while (reader.next(game)) {
+    ++counts->games;
+    counts->moves += game.moves.size();
+    if (out != nullptr) {
+      write_pgn(*out, game, notation);
+    }
+  }
+  counts->errors = reader.get_errors();
+}
+
+void replay_pgn(const std::string_view text, int workers, std::ostream *out,
+                const MoveNotation notation, std::ostream &log) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::string_view> shards =
+      split_pgn(text, out != nullptr ? 1 : std::max(1, workers));
+
+  // Each worker reads its own shard, counts are only read once joined.
+  std::vector<ReplayCounts> counts(shards.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < shards.size(); ++i) {
+    threads.push_back(
+        std::thread(replay_shard, shards[i], out, notation, &counts[i]));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  if (out != nullptr) {
+    out->flush();
+  }
+
+  ReplayCounts total;
+  for (const ReplayCounts &shard : counts) {
+    total.games += shard.games;
+    total.moves += shard.moves;
+    total.errors += shard.errors;
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  log << total.games << " games, " << total.moves << " moves, "
+      << total.errors << " skipped in " << seconds << "s, "
+      << total.games / seconds * 60 << " games/minute" << std::endl;
+}
\ No newline at end of file
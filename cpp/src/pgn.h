@@ -0,0 +1,174 @@
+#ifndef PGN_H
+#define PGN_H
+
+#include "board.h"
+#include "move.h"
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * Notation of moves written to PGN.
+ */
+enum class MoveNotation {
+  /// Standard algebraic notation, e.g. "Nf3".
+  SAN,
+
+  /// UCI long algebraic notation, e.g. "g1f3". Not standard PGN, but read
+  /// back by `PgnReader`.
+  UCI
+};
+
+/**
+ * Record of one game in Portable Game Notation (PGN).
+ */
+struct PgnGame {
+  /// Tag pairs in output order, starting with the seven tag roster (Event,
+  /// Site, Date, Round, White, Black, Result). A FEN tag sets the start
+  /// position, the standard start position otherwise.
+  std::vector<std::pair<std::string, std::string>> tags;
+
+  /// Moves played from the start position, each valid in its position.
+  std::vector<Move> moves;
+
+  /// Result of game, "1-0", "0-1", "1/2-1/2" or "*" if unknown.
+  std::string result = "*";
+};
+
+/**
+ * Converts a valid move into standard algebraic notation (SAN), with the
+ * origin file or rank added only where another piece of the same type could
+ * reach the destination (e.g. "Nbd7", "exd6", "e8=Q+", "O-O-O#").
+ *
+ * @param b Board move is played on, before the move.
+ * @param move Move to convert, valid on `b`.
+ * @return SAN string of `move`.
+ */
+std::string move_to_san(const Board &b, const Move &move);
+
+/**
+ * Outputs a game in PGN: its tag pairs, then its moves with move numbers,
+ * wrapped before 80 columns, then its result and a blank line. Games are
+ * written one at a time, so any number of games can be streamed to `os`.
+ *
+ * @param os Stream to output to.
+ * @param game Game to output, moves valid from its start position.
+ * @param notation Notation of moves.
+ * @return Reference to `os`.
+ */
+std::ostream &write_pgn(std::ostream &os, const PgnGame &game,
+                        const MoveNotation notation = MoveNotation::SAN);
+
+/**
+ * Reads the games of PGN text one at a time, resolving each move against the
+ * valid moves of its position. Tokens are views of the text, so reading
+ * allocates nothing once the storage of the game being read into has grown
+ * to fit.
+ *
+ * Comments, variations, numeric annotation glyphs and move suffixes such as
+ * "!?" are skipped. Moves may be in SAN or in UCI long algebraic notation.
+ * Games with a move that is not valid, or with a FEN tag that is not valid,
+ * are skipped and counted.
+ */
+class PgnReader {
+public:
+  /**
+   * Constructs reader of PGN text.
+   *
+   * @param text Text to read, must stay valid while reading. A shard from
+   * `split_pgn` or a whole file.
+   */
+  PgnReader(const std::string_view text);
+
+  /**
+   * Reads the next game.
+   *
+   * @param game Set to tags, moves and result of the next game, its storage
+   * reused.
+   * @return Boolean value if a game was read, false once the text ends.
+   */
+  bool next(PgnGame &game);
+
+  /**
+   * Getter for `m_errors`.
+   *
+   * @return Number of games skipped so far.
+   */
+  size_t get_errors() const { return m_errors; }
+
+private:
+  /// Text being read.
+  std::string_view m_text;
+
+  /// Offset of the next character to read.
+  size_t m_position;
+
+  /// Number of games skipped for a move or FEN tag that is not valid.
+  size_t m_errors;
+
+  /// Board the moves of the current game are played on.
+  Board m_board;
+
+  /**
+   * Skips whitespace, comments, escape lines, numeric annotation glyphs and
+   * variations.
+   */
+  void skip_separators();
+
+  /**
+   * Reads one tag pair, the next character being '['.
+   *
+   * @param game Game to store tag pair in.
+   * @param tag_count Number of tag pairs of `game` read so far, incremented.
+   */
+  void read_tag(PgnGame &game, size_t &tag_count);
+
+  /**
+   * Reads the movetext of a game up to its result, playing each move.
+   *
+   * @param game Game to store moves and result in.
+   * @return Boolean value if every move was valid.
+   */
+  bool read_movetext(PgnGame &game);
+
+  /**
+   * Finds the valid move of the current position written by a move token.
+   *
+   * @param token Move in SAN or UCI notation, without suffixes.
+   * @return Move written by `token`, empty move if none or more than one.
+   */
+  Move resolve_move(const std::string_view token);
+};
+
+/**
+ * Splits PGN text into shards that each start at the beginning of a game, so
+ * each shard can be read by its own `PgnReader`. Shards are about equal in
+ * bytes, but fewer than `count` if the text has fewer games.
+ *
+ * @param text PGN text.
+ * @param count Number of shards wanted.
+ * @return Shards of `text`, in order.
+ */
+std::vector<std::string_view> split_pgn(const std::string_view text,
+                                        const int count);
+
+/**
+ * Replays every game of PGN text through `Board`, each shard of the text on
+ * its own worker thread, and outputs the number of games, moves, skipped
+ * games and games per minute to `log`.
+ *
+ * @param text PGN text.
+ * @param workers Number of worker threads, a single one if `out` is set so
+ * games are written in order.
+ * @param out Stream to write every game to again, nullptr for none.
+ * @param notation Notation of moves written to `out`.
+ * @param log Stream to output counts to.
+ */
+void replay_pgn(const std::string_view text, int workers, std::ostream *out,
+                const MoveNotation notation, std::ostream &log);
+
+#endif
\ No newline at end of file
@@ -1,164 +1,80 @@
 #include "piece.h"
 #include "board.h"
 
-#include "piece/bishop.h"
-#include "piece/knight.h"
-#include "piece/queen.h"
-#include "piece/rook.h"
+void Piece::get_moves(MoveList &moves, const bool in_check_moves) const {
+  if (!in_check_moves) {
+    get_moves(moves, m_board->check_info(m_color));
+    return;
+  }
 
-std::vector<Move> Piece::get_moves(const bool in_check_moves) const {
   // All moves of piece, whether valid or not.
-  std::vector<Move> candidate_moves = get_candidate_moves(in_check_moves);
-  // All valid moves of piece.
-  std::vector<Move> moves;
-
+  MoveList candidate_moves;
+  get_candidate_moves(candidate_moves, in_check_moves);
   for (const Move &move : candidate_moves) {
-    // If move destination is not in board, do not add to valid moves.
-    if (!m_board->contains(move.get_dest())) {
-      continue;
-    }
-
     // If piece captures own color piece, do not add to valid moves.
-    if (m_board->piece_at(move.get_dest()) != nullptr &&
-        m_board->piece_at(move.get_dest())->get_color() == m_color) {
-      continue;
+    if (!(m_board->occupancy(m_color) &
+          square_bb(to_square(move.get_dest())))) {
+      moves.push_back(move);
     }
-
-    // If move puts board in check for color, do not add to valid moves.
-    if (!in_check_moves) {
-      Board candidate_board(*m_board);
-      candidate_board.piece_at(m_coordinate)->move(move);
-      if (candidate_board.in_check(m_color)) {
-        continue;
-      }
-    }
-
-    moves.push_back(move);
   }
-
-  return moves;
 }
 
-void Piece::move(const Move &move) {
-  // Get rank and file of destination.
-  int rank = move.get_dest().get_rank(), file = move.get_dest().get_file();
-
-  // Update draw counter on board.
-  if (m_board->piece_at(move.get_dest()) != nullptr ||
-      get_type() == Piece::Type::PAWN) {
-    m_board->m_draw_counter = 0;
-  } else {
-    m_board->m_draw_counter += 1;
-  }
-
-  // Phyiscally move piece on board object. Update piece data.
-  m_board->m_board[m_coordinate.get_rank()][m_coordinate.get_file()] = nullptr;
-  delete m_board->m_board[rank][file];
-  m_board->m_board[rank][file] = this;
-  m_moved = true;
-  m_coordinate = move.get_dest();
-
-  // Update `m_empassant_target` of board if pawn double move.
-  if (move.get_type() == Move::MoveType::DOUBLE) {
-    m_board->m_empassant_target =
-        Coordinate(rank + ((m_color == Color::WHITE) ? -1 : 1), file);
-  } else {
-    m_board->m_empassant_target = Coordinate(-1, -1);
+void Piece::get_moves(MoveList &moves, const CheckInfo &info,
+                      const Bitboard filter) const {
+  // All moves of piece, whether valid or not.
+  MoveList candidate_moves;
+  get_candidate_moves(candidate_moves);
+
+  // Squares the piece may move to, never onto an own piece.
+  int from = to_square(m_coordinate);
+  Bitboard targets = ~m_board->occupancy(m_color) & filter;
+
+  // King moves are tested directly, with the king taken off the board so it
+  // does not block a slider attacking the square behind it.
+  if (get_type() == Type::KING) {
+    Bitboard occupied = m_board->occupancy() ^ square_bb(from);
+    Bitboard enemies = m_board->occupancy(
+        m_color == Color::WHITE ? Color::BLACK : Color::WHITE);
+    for (const Move &move : candidate_moves) {
+      int dest = to_square(move.get_dest());
+      if ((targets & square_bb(dest)) &&
+          !(m_board->attackers_to(dest, occupied) & enemies)) {
+        moves.push_back(move);
+      }
+    }
+    return;
   }
 
-  // Add move to board move history.
-  m_board->add_move(move);
-
-  /*
-    Handle special case moves.
-
-    1. Change piece type if pawn promotion.
-    2. Move rook if castling move.
-    3. Remove enemy pawn if em passant move.
-  */
-  switch (move.get_type()) {
-  case Move::MoveType::KNIGHT_PROMOTION:
-    m_board->m_board[rank][file] =
-        new Knight(m_board, get_color(), move.get_dest(), true);
-    delete this;
-    break;
-
-  case Move::MoveType::BISHOP_PROMOTION:
-    m_board->m_board[rank][file] =
-        new Bishop(m_board, get_color(), move.get_dest(), true);
-    delete this;
-    break;
-
-  case Move::MoveType::ROOK_PROMOTION:
-    m_board->m_board[rank][file] =
-        new Rook(m_board, get_color(), move.get_dest(), true);
-    delete this;
-    break;
-
-  case Move::MoveType::QUEEN_PROMOTION:
-    m_board->m_board[rank][file] =
-        new Queen(m_board, get_color(), move.get_dest(), true);
-    delete this;
-    break;
-
-  case Move::MoveType::QUEEN_CASTLE:
-    m_board->m_board[rank][file + 1] = m_board->m_board[rank][0];
-    m_board->m_board[rank][0] = nullptr;
-    m_board->m_board[rank][file + 1]->m_moved = true;
-    break;
-
-  case Move::MoveType::KING_CASTLE:
-    m_board->m_board[rank][file - 1] = m_board->m_board[rank][7];
-    m_board->m_board[rank][7] = nullptr;
-    m_board->m_board[rank][file - 1]->m_moved = true;
-    break;
-
-  case Move::MoveType::EM_PASSANT:
-    delete m_board
-        ->m_board[rank + (m_color == Piece::Color::WHITE ? -1 : 1)][file];
-    m_board->m_board[rank + (m_color == Piece::Color::WHITE ? -1 : 1)][file] =
-        nullptr;
-    break;
-
-  default:
-    break;
+  targets &= info.check_mask;
+  if (info.pinned & square_bb(from)) {
+    targets &= line(info.king, from);
   }
-}
-
-std::vector<Move> Piece::get_straight_moves() const {
-  std::vector<Move> straight_moves;
-
-  std::vector<std::vector<int>> dirs{{1, 0}, {0, -1}, {-1, 0}, {0, 1}};
-  for (const std::vector<int> &dir : dirs) {
-    for (Coordinate dest(m_coordinate.get_rank() + dir[0],
-                         m_coordinate.get_file() + dir[1]);
-         m_board->contains(dest); dest = Coordinate(dest.get_rank() + dir[0],
-                                                    dest.get_file() + dir[1])) {
-      straight_moves.push_back(Move(m_coordinate, dest));
-      if (m_board->piece_at(dest) != nullptr) {
-        break;
+  for (const Move &move : candidate_moves) {
+    if (move.get_type() == Move::MoveType::EM_PASSANT) {
+      if ((filter & square_bb(to_square(move.get_dest()))) &&
+          m_board->empassant_legal(move)) {
+        moves.push_back(move);
       }
+    } else if (targets & square_bb(to_square(move.get_dest()))) {
+      moves.push_back(move);
     }
   }
-
-  return straight_moves;
 }
 
-std::vector<Move> Piece::get_diagonal_moves() const {
-  std::vector<Move> diagonal_moves;
+void Piece::move(const Move &move) { m_board->make_move(move); }
 
-  std::vector<std::vector<int>> dirs{{1, 1}, {1, -1}, {-1, -1}, {-1, 1}};
-  for (const std::vector<int> &dir : dirs) {
-    for (Coordinate dest(m_coordinate.get_rank() + dir[0],
-                         m_coordinate.get_file() + dir[1]);
-         m_board->contains(dest); dest = Coordinate(dest.get_rank() + dir[0],
-                                                    dest.get_file() + dir[1])) {
-      diagonal_moves.push_back(Move(m_coordinate, dest));
-      if (m_board->piece_at(dest) != nullptr) {
-        break;
-      }
-    }
+void Piece::get_straight_moves(MoveList &moves) const {
+  Bitboard attacks =
+      rook_attacks(to_square(m_coordinate), m_board->occupancy());
+  while (attacks) {
+    moves.push_back(Move(m_coordinate, to_coordinate(pop_lsb(attacks))));
   }
+}
 
-  return diagonal_moves;
+void Piece::get_diagonal_moves(MoveList &moves) const {
+  Bitboard attacks =
+      bishop_attacks(to_square(m_coordinate), m_board->occupancy());
+  while (attacks) {
+    moves.push_back(Move(m_coordinate, to_coordinate(pop_lsb(attacks))));
+  }
 }
\ No newline at end of file
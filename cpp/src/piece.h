@@ -1,18 +1,21 @@
 #ifndef PIECE_H
 #define PIECE_H
 
+#include "bitboard.h"
 #include "coordinate.h"
 #include "move.h"
-
-#include <vector>
+#include "movelist.h"
 
 class Board;
+struct CheckInfo;
 
 /**
  * Piece parent class. Contains utility functions to operator on pieces.
  */
 class Piece {
 public:
+  friend class Board;
+
   /// Color enum.
   enum class Color { WHITE, BLACK };
 
@@ -68,22 +71,39 @@ public:
    * Obtains a list of all possible moves of a piece depending on piece move
    * specifications.
    *
+   * @param moves List to append possible moves of piece to.
    * @param in_check_moves Boolean to test only capturing moves if in check.
-   * @return Vector of possible moves of piece.
    */
-  virtual std::vector<Move>
-  get_candidate_moves(const bool in_check_moves = false) const = 0;
+  virtual void get_candidate_moves(MoveList &moves,
+                                   const bool in_check_moves = false) const = 0;
 
   /**
-   * Obtains a list of all valid moves of a piece.
+   * Obtains a list of all valid moves of a piece. Computes the legality masks
+   * of the piece's color, see the overload taking them.
    *
-   * @param in_check_moves Boolean to test only capturing moves if in check.
-   * @return Vector of valid moves of piece.
+   * @param moves List to append valid moves of piece to.
+   * @param in_check_moves Boolean to skip legality tests, keeping every
+   * candidate move that does not capture an own piece.
+   */
+  void get_moves(MoveList &moves, const bool in_check_moves = false) const;
+
+  /**
+   * Obtains a list of all valid moves of a piece without playing them. King
+   * moves must not land on an attacked square, other moves must resolve any
+   * check and stay on the pin line of a pinned piece.
+   *
+   * @param moves List to append valid moves of piece to.
+   * @param info Legality masks of the piece's color.
+   * @param filter Bitboard of destination squares to keep, used to generate
+   * captures and quiet moves separately. Em passant moves land on the em
+   * passant target.
    */
-  std::vector<Move> get_moves(const bool in_check_moves = false) const;
+  void get_moves(MoveList &moves, const CheckInfo &info,
+                 const Bitboard filter = ~Bitboard(0)) const;
 
   /**
-   * Moves the current piece object on the board.
+   * Moves the current piece object on the board. Move can be taken back with
+   * `Board::unmake_move`.
    *
    * @param move Move specifications to carry out.
    */
@@ -103,18 +123,20 @@ protected:
   bool m_moved;
 
   /**
-   * Helper function for rook and queen candidate moves.
+   * Helper function for rook and queen candidate moves. Uses the magic
+   * bitboard rook attack lookup.
    *
-   * @return Vector of all possible straight moves from piece.
+   * @param moves List to append all possible straight moves from piece to.
    */
-  std::vector<Move> get_straight_moves() const;
+  void get_straight_moves(MoveList &moves) const;
 
   /**
-   * Helper function for bishop and queen candidate moves.
+   * Helper function for bishop and queen candidate moves. Uses the magic
+   * bitboard bishop attack lookup.
    *
-   * @return Vector of all possible diagonal moves from piece.
+   * @param moves List to append all possible diagonal moves from piece to.
    */
-  std::vector<Move> get_diagonal_moves() const;
+  void get_diagonal_moves(MoveList &moves) const;
 };
 
 #endif
\ No newline at end of file
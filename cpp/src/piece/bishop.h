@@ -31,12 +31,12 @@ public:
    *
    * For bishop, will add all diagonal moves from bishop.
    *
+   * @param moves List to append possible moves of bishop to.
    * @param in_check_moves Boolean to test only capturing moves if in check.
-   * @return Vector of possible moves of bishop.
    */
-  std::vector<Move>
-  get_candidate_moves(const bool in_check_moves = false) const override {
-    return get_diagonal_moves();
+  void get_candidate_moves(MoveList &moves,
+                           const bool in_check_moves = false) const override {
+    get_diagonal_moves(moves);
   }
 };
 
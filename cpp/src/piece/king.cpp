@@ -2,28 +2,29 @@
 
 #include "../board.h"
 
-std::vector<Move> King::get_candidate_moves(const bool in_check_moves) const {
-  std::vector<Move> candidate_moves;
-
-  // Add single moves from king
-  for (int rank_offset = -1; rank_offset <= 1; ++rank_offset) {
-    for (int file_offset = -1; file_offset <= 1; ++file_offset) {
-      if (rank_offset == 0 && file_offset == 0) {
-        continue;
-      }
-      candidate_moves.push_back(Move(
-          m_coordinate, Coordinate(m_coordinate.get_rank() + rank_offset,
-                                   m_coordinate.get_file() + file_offset)));
-    }
+void King::get_candidate_moves(MoveList &candidate_moves,
+                               const bool in_check_moves) const {
+  // Add single moves from king, moves off the board are not in the attack
+  // table.
+  Bitboard attacks = king_attacks(to_square(m_coordinate));
+  while (attacks) {
+    candidate_moves.push_back(
+        Move(m_coordinate, to_coordinate(pop_lsb(attacks))));
   }
 
   // Add castling moves
-  if (!in_check_moves && !m_moved && !(m_board->in_check(m_color))) {
+  if (!in_check_moves && !(m_board->in_check(m_color))) {
     for (int rook_file : {0, 7}) {
+      int right = rook_file == 7 ? Board::WHITE_KING_CASTLE
+                                 : Board::WHITE_QUEEN_CASTLE;
+      if (m_color == Piece::Color::BLACK) {
+        right <<= 2;
+      }
       Piece *rook =
           m_board->piece_at(Coordinate(m_coordinate.get_rank(), rook_file));
-      if (rook != nullptr && rook->get_type() == Piece::Type::ROOK &&
-          !(rook->get_moved())) {
+      if ((m_board->get_castling_rights() & right) && rook != nullptr &&
+          rook->get_type() == Piece::Type::ROOK &&
+          rook->get_color() == m_color) {
         int direction = m_coordinate.get_file() < rook_file ? 1 : -1;
 
         // Check if castling is blocked by any piece.
@@ -40,12 +41,11 @@ std::vector<Move> King::get_candidate_moves(const bool in_check_moves) const {
         }
 
         // Prevent castling through check.
-        Board candidate_board(*m_board);
-        candidate_board.piece_at(m_coordinate)
-            ->move(Move(m_coordinate,
-                        Coordinate(m_coordinate.get_rank(),
-                                   m_coordinate.get_file() + direction)));
-        if (candidate_board.in_check(m_color)) {
+        if (m_board->is_square_attacked(
+                Coordinate(m_coordinate.get_rank(),
+                           m_coordinate.get_file() + direction),
+                m_color == Piece::Color::WHITE ? Piece::Color::BLACK
+                                               : Piece::Color::WHITE)) {
           continue;
         }
         candidate_moves.push_back(
@@ -58,6 +58,4 @@ std::vector<Move> King::get_candidate_moves(const bool in_check_moves) const {
       }
     }
   }
-
-  return candidate_moves;
 }
\ No newline at end of file
@@ -31,11 +31,11 @@ public:
    *
    * For knight, will add all L-moves from knight.
    *
+   * @param moves List to append possible moves of knight to.
    * @param in_check_moves Boolean to test only capturing moves if in check.
-   * @return Vector of possible moves of knight.
    */
-  std::vector<Move>
-  get_candidate_moves(const bool in_check_moves = false) const override;
+  void get_candidate_moves(MoveList &moves,
+                           const bool in_check_moves = false) const override;
 };
 
 #endif
\ No newline at end of file
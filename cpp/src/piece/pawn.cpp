@@ -2,68 +2,66 @@
 
 #include "../board.h"
 
-std::vector<Move> Pawn::get_candidate_moves(const bool in_check_moves) const {
-  std::vector<Move> candidate_moves;
-  int direction = (m_color == Piece::Color::WHITE) ? 1 : -1;
+/**
+ * Adds the move of a pawn onto a square, as each promotion if the square is
+ * on the last rank. Pawns only reach their own last rank.
+ *
+ * @param candidate_moves List to add moves to.
+ * @param from Coordinate of pawn.
+ * @param dest Square index of destination.
+ */
+static void add_pawn_move(MoveList &candidate_moves, const Coordinate &from,
+                          const int dest) {
+  Coordinate destination = to_coordinate(dest);
+  if (square_bb(dest) & (RANK_1 | RANK_8)) {
+    candidate_moves.push_back(
+        Move(from, destination, Move::MoveType::KNIGHT_PROMOTION));
+    candidate_moves.push_back(
+        Move(from, destination, Move::MoveType::BISHOP_PROMOTION));
+    candidate_moves.push_back(
+        Move(from, destination, Move::MoveType::ROOK_PROMOTION));
+    candidate_moves.push_back(
+        Move(from, destination, Move::MoveType::QUEEN_PROMOTION));
+  } else {
+    candidate_moves.push_back(Move(from, destination));
+  }
+}
 
-  // Add single move, if single move ends up on other side of board, add
-  // promotion.
-  Coordinate destination = Coordinate(m_coordinate.get_rank() + (1 * direction),
-                                      m_coordinate.get_file());
-  if (!m_board->piece_at(destination) && m_board->contains(destination)) {
-    if ((destination.get_rank() == m_board->SIZE - 1 &&
-         m_color == Piece::Color::WHITE) ||
-        (destination.get_rank() == 0 && m_color == Piece::Color::BLACK)) {
-      candidate_moves.push_back(
-          Move(m_coordinate, destination, Move::MoveType::KNIGHT_PROMOTION));
-      candidate_moves.push_back(
-          Move(m_coordinate, destination, Move::MoveType::BISHOP_PROMOTION));
-      candidate_moves.push_back(
-          Move(m_coordinate, destination, Move::MoveType::ROOK_PROMOTION));
-      candidate_moves.push_back(
-          Move(m_coordinate, destination, Move::MoveType::QUEEN_PROMOTION));
-    } else {
-      candidate_moves.push_back(Move(m_coordinate, destination));
-    }
+void Pawn::get_candidate_moves(MoveList &candidate_moves,
+                               const bool in_check_moves) const {
+  int square = to_square(m_coordinate);
+  int color = int(m_color);
+  Bitboard empty = ~m_board->occupancy();
 
-    // Add double move from starting position.
-    destination = Coordinate(m_coordinate.get_rank() + (2 * direction),
-                             m_coordinate.get_file());
-    if (!m_board->piece_at(destination) && m_board->contains(destination) &&
-        !m_moved) {
-      candidate_moves.push_back(
-          Move(m_coordinate, destination, Move::MoveType::DOUBLE));
+  // Add single move, and double move from starting rank. A pawn is never on
+  // its last rank, so the step stays on the board.
+  int step = (m_color == Piece::Color::WHITE) ? 8 : -8;
+  Bitboard start_rank =
+      (m_color == Piece::Color::WHITE) ? RANK_1 << 8 : RANK_8 >> 8;
+  if (empty & square_bb(square + step)) {
+    add_pawn_move(candidate_moves, m_coordinate, square + step);
+    if ((start_rank & square_bb(square)) &&
+        (empty & square_bb(square + 2 * step))) {
+      candidate_moves.push_back(Move(m_coordinate,
+                                     to_coordinate(square + 2 * step),
+                                     Move::MoveType::DOUBLE));
     }
   }
 
-  // Add capturing moves (regular and em passant).
-  for (int offset : {-1, 1}) {
-    destination = Coordinate(m_coordinate.get_rank() + (1 * direction),
-                             m_coordinate.get_file() + offset);
-
-    if (m_board->contains(destination) &&
-        !(m_board->m_empassant_target == Coordinate(-1, -1)) &&
-        destination == m_board->m_empassant_target) {
-      candidate_moves.push_back(
-          Move(m_coordinate, destination, Move::MoveType::EM_PASSANT));
-    } else if (m_board->contains(destination) &&
-               m_board->piece_at(destination)) {
-      if ((destination.get_rank() == m_board->SIZE - 1 &&
-           m_color == Piece::Color::WHITE) ||
-          (destination.get_rank() == 0 && m_color == Piece::Color::BLACK)) {
-        candidate_moves.push_back(
-            Move(m_coordinate, destination, Move::MoveType::KNIGHT_PROMOTION));
-        candidate_moves.push_back(
-            Move(m_coordinate, destination, Move::MoveType::BISHOP_PROMOTION));
-        candidate_moves.push_back(
-            Move(m_coordinate, destination, Move::MoveType::ROOK_PROMOTION));
-        candidate_moves.push_back(
-            Move(m_coordinate, destination, Move::MoveType::QUEEN_PROMOTION));
-      } else {
-        candidate_moves.push_back(Move(m_coordinate, destination));
-      }
+  // Add capturing moves (regular and em passant), off-board captures are not
+  // in the attack table.
+  Bitboard empassant = m_board->contains(m_board->m_empassant_target)
+                           ? square_bb(to_square(m_board->m_empassant_target))
+                           : 0;
+  Bitboard attacks = pawn_attacks(color, square) &
+                     (m_board->occupancy(Piece::Color(color ^ 1)) | empassant);
+  while (attacks) {
+    int dest = pop_lsb(attacks);
+    if (square_bb(dest) & empassant) {
+      candidate_moves.push_back(Move(m_coordinate, to_coordinate(dest),
+                                     Move::MoveType::EM_PASSANT));
+    } else {
+      add_pawn_move(candidate_moves, m_coordinate, dest);
     }
   }
-
-  return candidate_moves;
 }
\ No newline at end of file
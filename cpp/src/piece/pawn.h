@@ -32,11 +32,11 @@ public:
    * For pawn, will add all single move forward, double move from start,
    * diagonal capture, em passant, and promotion moves.
    *
+   * @param moves List to append possible moves of pawn to.
    * @param in_check_moves Boolean to test only capturing moves if in check.
-   * @return Vector of possible moves of pawn.
    */
-  std::vector<Move>
-  get_candidate_moves(const bool in_check_moves = false) const override;
+  void get_candidate_moves(MoveList &moves,
+                           const bool in_check_moves = false) const override;
 };
 
 #endif
\ No newline at end of file
@@ -31,11 +31,11 @@ public:
    *
    * For queen, will add all straight and diagonal moves from queen.
    *
+   * @param moves List to append possible moves of queen to.
    * @param in_check_moves Boolean to test only capturing moves if in check.
-   * @return Vector of possible moves of queen.
    */
-  std::vector<Move>
-  get_candidate_moves(const bool in_check_moves = false) const override;
+  void get_candidate_moves(MoveList &moves,
+                           const bool in_check_moves = false) const override;
 };
 
 #endif
\ No newline at end of file
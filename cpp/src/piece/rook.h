@@ -31,12 +31,12 @@ public:
    *
    * For rook, will add all straight moves from rook.
    *
+   * @param moves List to append possible moves of rook to.
    * @param in_check_moves Boolean to test only capturing moves if in check.
-   * @return Vector of possible moves of rook.
    */
-  std::vector<Move>
-  get_candidate_moves(const bool in_check_moves = false) const override {
-    return get_straight_moves();
+  void get_candidate_moves(MoveList &moves,
+                           const bool in_check_moves = false) const override {
+    get_straight_moves(moves);
   }
 };
 
@@ -0,0 +1,623 @@
+#include "search.h"
+
+#include "evaluation.h"
+
+#include <algorithm>
+#include <thread>
+
+SearchContext::SearchContext(TranspositionTable *table, std::atomic<bool> *stop,
+                             const SearchLimits *limits)
+    : table(table), stop(stop), limits(limits), stats(),
+      start(std::chrono::steady_clock::now()), last_progress(start), ply(0),
+      killers(), history() {}
+
+/**
+ * Counts a node searched and stops the search once a limit of the thread is
+ * reached. The clock and cancel flag are only read, and progress only
+ * reported, every `LIMIT_CHECK_INTERVAL` nodes.
+ *
+ * @param context State of searching thread.
+ */
+static void visit_node(SearchContext &context) {
+  uint64_t nodes = ++context.stats.nodes;
+  if (context.limits == nullptr) {
+    return;
+  }
+  const SearchLimits &limits = *context.limits;
+  if (limits.nodes != 0 && nodes >= limits.nodes) {
+    context.stop->store(true, std::memory_order_relaxed);
+  }
+  if (nodes % LIMIT_CHECK_INTERVAL != 0) {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if ((limits.cancel != nullptr &&
+       limits.cancel->load(std::memory_order_relaxed)) ||
+      now >= limits.deadline) {
+    context.stop->store(true, std::memory_order_relaxed);
+  }
+  if (limits.progress &&
+      now - context.last_progress >= limits.progress_interval) {
+    context.last_progress = now;
+    limits.progress(nodes, now - context.start);
+  }
+}
+
+/**
+ * Probes the transposition table for the position of a node, counting the
+ * probe and whether it hit.
+ *
+ * @param b Board of node.
+ * @param entry Set to the stored result if found.
+ * @param context State of searching thread.
+ * @return Boolean value if a result is stored for the position.
+ */
+static bool probe_table(const Board &b, TranspositionTable::Entry &entry,
+                        SearchContext &context) {
+  ++context.stats.table_probes;
+  if (!context.table->probe(b.get_key(), entry)) {
+    return false;
+  }
+  ++context.stats.table_hits;
+  return true;
+}
+
+/**
+ * Counts a cutoff of an expanded node.
+ *
+ * @param moves_searched Number of moves searched by the node, including the
+ * move causing the cutoff.
+ * @param context State of searching thread.
+ */
+static void count_cutoff(const int moves_searched, SearchContext &context) {
+  ++context.stats.cutoffs;
+  if (moves_searched == 1) {
+    ++context.stats.first_move_cutoffs;
+  }
+}
+
+/**
+ * Determines if a move captures a piece.
+ *
+ * @param b Board move is played on, before the move.
+ * @param move Move to check.
+ * @return Boolean value if `move` is a capture.
+ */
+static bool is_capture(const Board &b, const Move &move) {
+  return b.piece_at(move.get_dest()) != nullptr ||
+         move.get_type() == Move::MoveType::EM_PASSANT;
+}
+
+/**
+ * Obtains the material value of the piece a capture takes.
+ *
+ * @param b Board capture is played on, before the capture.
+ * @param capture Capture to get value of.
+ * @return Value of captured piece in centipawns.
+ */
+static int captured_value(const Board &b, const Move &capture) {
+  const Piece *victim = b.piece_at(capture.get_dest());
+  return PIECE_VALUES[victim != nullptr ? int(victim->get_type())
+                                        : int(Piece::Type::PAWN)];
+}
+
+/**
+ * Remembers a quiet move that caused a cutoff, as a killer move of its ply
+ * and in the history of its color. Captures are ordered by the move picker
+ * on their own.
+ *
+ * @param b Board move was played on, before the move.
+ * @param color Color of move.
+ * @param move Move causing the cutoff.
+ * @param depth Remaining depth of node.
+ * @param context State of searching thread.
+ */
+static void update_cutoff(const Board &b, const Piece::Color color,
+                          const Move &move, const int depth,
+                          SearchContext &context) {
+  if (is_capture(b, move)) {
+    return;
+  }
+  if (context.ply < MAX_PLY) {
+    Move *killers = context.killers[context.ply];
+    if (killers[0].get_data() != move.get_data()) {
+      std::copy_backward(killers, killers + MovePicker::KILLERS - 1,
+                         killers + MovePicker::KILLERS);
+      killers[0] = move;
+    }
+  }
+  int(*history)[64] = context.history[int(color)];
+  int &value = history[to_square(move.get_from())][to_square(move.get_dest())];
+  value += depth * depth;
+
+  // Age the history of the color long before it could overflow.
+  if (value > MAX_HISTORY) {
+    for (int from = 0; from < 64; ++from) {
+      for (int dest = 0; dest < 64; ++dest) {
+        history[from][dest] /= 2;
+      }
+    }
+  }
+}
+
+/**
+ * Constructs the move picker of a node.
+ *
+ * @param b Board of node.
+ * @param color Color to move.
+ * @param hash_move Best move stored for the position, empty move if none.
+ * @param context State of searching thread.
+ * @return Move picker of node.
+ */
+static MovePicker node_picker(const Board &b, const Piece::Color color,
+                              const Move &hash_move, SearchContext &context) {
+  return MovePicker(b, color, hash_move,
+                    context.ply < MAX_PLY ? context.killers[context.ply]
+                                          : nullptr,
+                    context.history[int(color)]);
+}
+
+/// Margin added to the value of a capture in quiescence search before it is
+/// skipped for not raising the score enough (delta pruning).
+static const int DELTA_MARGIN = 200;
+
+/**
+ * Determines the bound type of a score searched with an alpha-beta window.
+ *
+ * @param score Score found.
+ * @param alpha Lower bound of window when search started.
+ * @param beta Upper bound of window.
+ * @return Bound type of `score`.
+ */
+static TranspositionTable::Bound score_bound(const int score, const int alpha,
+                                             const int beta) {
+  if (score <= alpha) {
+    return TranspositionTable::Bound::UPPER;
+  }
+  if (score >= beta) {
+    return TranspositionTable::Bound::LOWER;
+  }
+  return TranspositionTable::Bound::EXACT;
+}
+
+/**
+ * Flips a bound type for a score seen from the other color.
+ *
+ * @param bound Bound type.
+ * @return Bound type of the negated score.
+ */
+static TranspositionTable::Bound flip_bound(
+    const TranspositionTable::Bound bound) {
+  switch (bound) {
+  case TranspositionTable::Bound::LOWER:
+    return TranspositionTable::Bound::UPPER;
+  case TranspositionTable::Bound::UPPER:
+    return TranspositionTable::Bound::LOWER;
+  default:
+    return bound;
+  }
+}
+
+/**
+ * Determines if a stored result can be returned within an alpha-beta window.
+ *
+ * @param entry Stored result, score from the searching color's perspective.
+ * @param depth Remaining depth of current search.
+ * @param alpha Lower bound of window.
+ * @param beta Upper bound of window.
+ * @return Boolean value if `entry.score` can be returned.
+ */
+static bool usable_entry(const TranspositionTable::Entry &entry,
+                         const int depth, const int alpha, const int beta) {
+  return entry.depth >= depth &&
+         (entry.bound == TranspositionTable::Bound::EXACT ||
+          (entry.bound == TranspositionTable::Bound::LOWER &&
+           entry.score >= beta) ||
+          (entry.bound == TranspositionTable::Bound::UPPER &&
+           entry.score <= alpha));
+}
+
+/**
+ * Searches as a helper thread, only to fill the shared transposition table.
+ * Every other helper skips the first iteration, so threads are searching
+ * different depths at the same time.
+ *
+ * @param b Board to find move on, copied by the helper.
+ * @param color Color to find move of.
+ * @param depth Depth limit of last iteration of the calling thread.
+ * @param index Index of helper thread, from 1.
+ * @param table Transposition table shared by every search thread.
+ * @param stop Flag set once the search is over.
+ * @param stats Set to the counters of the helper once it is done.
+ */
+static void helper_search(const Board &b, Piece::Color color, int depth,
+                          int index, TranspositionTable *table,
+                          std::atomic<bool> *stop, SearchStats *stats) {
+  // Killer moves and history are kept per thread.
+  SearchContext context(table, stop);
+  Board helper_board(b);
+  for (int i = 1 + index % 2;
+       i <= depth + 1 && !context.stop->load(std::memory_order_relaxed); ++i) {
+    max_choice(helper_board, color, i, context);
+  }
+  *stats = context.stats;
+}
+
+Move find_move(const Board &b, Piece::Color color) {
+  static TranspositionTable table;
+  return find_move(b, color, table);
+}
+
+Move find_move(const Board &b, Piece::Color color, TranspositionTable &table,
+               int depth, int threads) {
+  SearchLimits limits;
+  limits.depth = depth;
+  return find_move(b, color, table, limits, threads);
+}
+
+Move find_move(const Board &b, Piece::Color color, TranspositionTable &table,
+               const SearchLimits &limits, int threads,
+               const std::function<void(const SearchInfo &)> &report,
+               SearchStats *stats) {
+  auto start = std::chrono::steady_clock::now();
+  Move best_move;
+  std::atomic<bool> stop(false);
+  SearchContext context(&table, &stop, &limits);
+
+  // Search a single copy of the board, moves are made and unmade in place.
+  Board choice_board(b);
+  table.new_search();
+
+  // Each thread counts into its own context, helper counts are only read
+  // once they are joined.
+  std::vector<std::thread> helpers;
+  std::vector<SearchStats> helper_stats(std::max(threads - 1, 0));
+  for (int i = 1; i < threads; ++i) {
+    helpers.push_back(std::thread(helper_search, std::cref(b), color,
+                                  limits.depth, i, &table, &stop,
+                                  &helper_stats[i - 1]));
+  }
+
+  // Use iterative deepening to find best move using depth limited minimax.
+  // Deeper iterations reuse positions stored in the table by earlier ones.
+  for (int i = 1; i <= limits.depth; ++i) {
+    auto iteration_start = std::chrono::steady_clock::now();
+    uint64_t iteration_nodes = context.stats.nodes;
+    std::pair<Move, int> choice_action =
+        max_choice(choice_board, color, i, context);
+    if (stop.load(std::memory_order_relaxed)) {
+      // An unfinished iteration is only used if none finished.
+      if (best_move == Move()) {
+        best_move = choice_action.first;
+      }
+      break;
+    }
+    best_move = choice_action.first;
+    context.stats.iterations.push_back(
+        {i, context.stats.nodes - iteration_nodes,
+         std::chrono::steady_clock::now() - iteration_start});
+
+    if (report && !(best_move == Move())) {
+      SearchInfo info;
+      info.depth = i;
+      info.score = choice_action.second;
+      info.nodes = context.stats.nodes;
+      info.elapsed = std::chrono::steady_clock::now() - start;
+      info.pv = principal_variation(b, best_move, table, i);
+      report(info);
+    }
+  }
+
+  stop.store(true, std::memory_order_relaxed);
+  for (std::thread &helper : helpers) {
+    helper.join();
+  }
+  if (stats != nullptr) {
+    *stats = context.stats;
+    for (const SearchStats &helper : helper_stats) {
+      *stats += helper;
+    }
+    stats->threads = std::max(threads, 1);
+    stats->elapsed = std::chrono::steady_clock::now() - start;
+  }
+
+  if (best_move == Move()) {
+    MoveList moves;
+    b.get_moves(color, moves);
+    if (!moves.empty()) {
+      best_move = moves[0];
+    }
+  }
+  return best_move;
+}
+
+int reported_score(int score) {
+  return std::max(-MAX_REPORTED_SCORE, std::min(MAX_REPORTED_SCORE, score));
+}
+
+std::vector<Move> principal_variation(const Board &b, const Move &move,
+                                      const TranspositionTable &table,
+                                      int length) {
+  std::vector<Move> pv(1, move);
+  Board pv_board(b);
+  pv_board.make_move(move);
+
+  // Stored moves may come from another position with the same key, only
+  // follow valid ones.
+  TranspositionTable::Entry entry;
+  while (int(pv.size()) < length && table.probe(pv_board.get_key(), entry) &&
+         !(entry.move == Move())) {
+    MoveList moves;
+    pv_board.get_moves(pv_board.get_current_move(), moves);
+    if (std::none_of(moves.begin(), moves.end(), [&entry](const Move &valid) {
+          return valid.get_data() == entry.move.get_data();
+        })) {
+      break;
+    }
+    pv.push_back(entry.move);
+    pv_board.make_move(entry.move);
+  }
+  return pv;
+}
+
+std::pair<Move, int> max_choice(Board &b, Piece::Color color, int depth,
+                                SearchContext &context) {
+  visit_node(context);
+  int action_val = 0;
+  std::pair<Move, int> max_action(Move(), INT_MIN);
+
+  // Search best move of previous iteration first.
+  TranspositionTable::Entry entry;
+  Move hash_move = probe_table(b, entry, context) ? entry.move : Move();
+  MovePicker picker = node_picker(b, color, hash_move, context);
+  ++context.stats.expanded_nodes;
+
+  // Depth limited minimax with alpha-beta pruning
+  Move move;
+  while (picker.next(move)) {
+    ++context.stats.moves_searched;
+    b.make_move(move);
+    ++context.ply;
+    action_val = min_value(b, color, depth - 1,
+                           std::max(max_action.second, -MAX_SCORE), MAX_SCORE,
+                           context);
+    --context.ply;
+    b.unmake_move();
+    if (context.stop->load(std::memory_order_relaxed)) {
+      return max_action;
+    }
+    if (action_val > max_action.second) {
+      max_action = std::pair<Move, int>(move, action_val);
+    }
+  }
+
+  if (!(max_action.first == Move())) {
+    context.table->store(b.get_key(), depth, TranspositionTable::Bound::EXACT,
+                         max_action.second, max_action.first);
+  }
+  return max_action;
+}
+
+int min_value(Board &b, Piece::Color color, int depth, int alpha, int beta,
+              SearchContext &context) {
+  visit_node(context);
+  int action_val = 0, min_action = MAX_SCORE;
+  Piece::Color opposite_color = (color == Piece::Color::WHITE)
+                                    ? Piece::Color::BLACK
+                                    : Piece::Color::WHITE;
+
+  // Avoid draw other color
+  if (b.draw()) {
+    return -MAX_SCORE;
+  }
+  // Reuse result of this position if searched at least as deep. Scores are
+  // stored from the perspective of the color to move.
+  TranspositionTable::Entry entry;
+  Move hash_move;
+  if (probe_table(b, entry, context)) {
+    entry.score = -entry.score;
+    entry.bound = flip_bound(entry.bound);
+    if (usable_entry(entry, depth, alpha, beta)) {
+      ++context.stats.table_cutoffs;
+      return entry.score;
+    }
+    hash_move = entry.move;
+  }
+  // Avoid stalemate other color
+  if (b.stalemated(opposite_color)) {
+    return -MAX_SCORE;
+  }
+  // Prefer check/checkmate other color
+  if (b.in_check(opposite_color) || b.checkmated(opposite_color)) {
+    return min_action;
+  }
+  // Base case, resolve pending captures before scoring.
+  if (depth == 0) {
+    return min_quiescence(b, color, alpha, beta, context);
+  }
+
+  // Iterate through valid moves in search order, stop once max can avoid this
+  // node.
+  MovePicker picker = node_picker(b, opposite_color, hash_move, context);
+  Move move, min_move;
+  int original_beta = beta, moves_searched = 0;
+  ++context.stats.expanded_nodes;
+  while (picker.next(move)) {
+    ++moves_searched;
+    b.make_move(move);
+    ++context.ply;
+    action_val = max_value(b, color, depth - 1, alpha, beta, context);
+    --context.ply;
+    b.unmake_move();
+    if (context.stop->load(std::memory_order_relaxed)) {
+      return 0;
+    }
+    if (action_val < min_action) {
+      min_action = action_val;
+      min_move = move;
+    }
+    beta = std::min(beta, min_action);
+    if (alpha >= beta) {
+      update_cutoff(b, opposite_color, move, depth, context);
+      count_cutoff(moves_searched, context);
+      break;
+    }
+  }
+  context.stats.moves_searched += moves_searched;
+
+  context.table->store(
+      b.get_key(), depth,
+      flip_bound(score_bound(min_action, alpha, original_beta)), -min_action,
+      min_move);
+  return min_action;
+}
+
+int max_value(Board &b, Piece::Color color, int depth, int alpha, int beta,
+              SearchContext &context) {
+  visit_node(context);
+  int action_val = 0, max_action = -MAX_SCORE;
+
+  // Avoid draw other color
+  if (b.draw()) {
+    return MAX_SCORE;
+  }
+  // Reuse result of this position if searched at least as deep.
+  TranspositionTable::Entry entry;
+  Move hash_move;
+  if (probe_table(b, entry, context)) {
+    if (usable_entry(entry, depth, alpha, beta)) {
+      ++context.stats.table_cutoffs;
+      return entry.score;
+    }
+    hash_move = entry.move;
+  }
+  // Avoid stalemate other color
+  if (b.stalemated(color)) {
+    return MAX_SCORE;
+  }
+  // Prefer check/checkmate other color
+  if (b.in_check(color) || b.checkmated(color)) {
+    return max_action;
+  }
+  // Base case, resolve pending captures before scoring.
+  if (depth == 0) {
+    return max_quiescence(b, color, alpha, beta, context);
+  }
+
+  // Iterate through valid moves in search order, stop once min can avoid this
+  // node.
+  MovePicker picker = node_picker(b, color, hash_move, context);
+  Move move, max_move;
+  int original_alpha = alpha, moves_searched = 0;
+  ++context.stats.expanded_nodes;
+  while (picker.next(move)) {
+    ++moves_searched;
+    b.make_move(move);
+    ++context.ply;
+    action_val = min_value(b, color, depth - 1, alpha, beta, context);
+    --context.ply;
+    b.unmake_move();
+    if (context.stop->load(std::memory_order_relaxed)) {
+      return 0;
+    }
+    if (action_val > max_action) {
+      max_action = action_val;
+      max_move = move;
+    }
+    alpha = std::max(alpha, max_action);
+    if (alpha >= beta) {
+      update_cutoff(b, color, move, depth, context);
+      count_cutoff(moves_searched, context);
+      break;
+    }
+  }
+  context.stats.moves_searched += moves_searched;
+
+  context.table->store(b.get_key(), depth,
+                       score_bound(max_action, original_alpha, beta),
+                       max_action, max_move);
+  return max_action;
+}
+
+int min_quiescence(Board &b, Piece::Color color, int alpha, int beta,
+                   SearchContext &context) {
+  visit_node(context);
+  ++context.stats.quiescence_nodes;
+  Piece::Color opposite_color = (color == Piece::Color::WHITE)
+                                    ? Piece::Color::BLACK
+                                    : Piece::Color::WHITE;
+
+  // Prefer check/checkmate other color, as in `min_value`.
+  if (b.in_check(opposite_color)) {
+    return MAX_SCORE;
+  }
+
+  // Other color may stand pat instead of capturing.
+  int stand_pat = b.get_score(color);
+  if (stand_pat <= alpha) {
+    return stand_pat;
+  }
+  int min_action = stand_pat;
+  beta = std::min(beta, stand_pat);
+
+  MovePicker picker(b, opposite_color);
+  Move move;
+  while (picker.next(move)) {
+    // Skip captures that cannot bring the score below beta.
+    if (stand_pat - captured_value(b, move) - DELTA_MARGIN >= beta) {
+      continue;
+    }
+    b.make_move(move);
+    int action_val = max_quiescence(b, color, alpha, beta, context);
+    b.unmake_move();
+    if (context.stop->load(std::memory_order_relaxed)) {
+      return 0;
+    }
+    min_action = std::min(min_action, action_val);
+    beta = std::min(beta, min_action);
+    if (alpha >= beta) {
+      break;
+    }
+  }
+  return min_action;
+}
+
+int max_quiescence(Board &b, Piece::Color color, int alpha, int beta,
+                   SearchContext &context) {
+  visit_node(context);
+  ++context.stats.quiescence_nodes;
+
+  // Prefer check/checkmate other color, as in `max_value`.
+  if (b.in_check(color)) {
+    return -MAX_SCORE;
+  }
+
+  // Color may stand pat instead of capturing.
+  int stand_pat = b.get_score(color);
+  if (stand_pat >= beta) {
+    return stand_pat;
+  }
+  int max_action = stand_pat;
+  alpha = std::max(alpha, stand_pat);
+
+  MovePicker picker(b, color);
+  Move move;
+  while (picker.next(move)) {
+    // Skip captures that cannot raise the score above alpha.
+    if (stand_pat + captured_value(b, move) + DELTA_MARGIN <= alpha) {
+      continue;
+    }
+    b.make_move(move);
+    int action_val = min_quiescence(b, color, alpha, beta, context);
+    b.unmake_move();
+    if (context.stop->load(std::memory_order_relaxed)) {
+      return 0;
+    }
+    max_action = std::max(max_action, action_val);
+    alpha = std::max(alpha, max_action);
+    if (alpha >= beta) {
+      break;
+    }
+  }
+  return max_action;
+}
\ No newline at end of file
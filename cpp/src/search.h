@@ -0,0 +1,285 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "board.h"
+#include "move.h"
+#include "movepicker.h"
+#include "piece.h"
+#include "searchstats.h"
+#include "transposition.h"
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/// Score of a won position for the searching color, negated for a lost one.
+const int MAX_SCORE = INT_MAX - 1;
+
+/// Largest score reported in centipawns. Won and lost positions are scored
+/// `MAX_SCORE`, which has no mate distance to report.
+const int MAX_REPORTED_SCORE = 30000;
+
+/// Depth limit of the last iteration of `find_move`.
+const int DEFAULT_DEPTH = 4;
+
+/// Number of plies from the root that killer moves are kept for.
+const int MAX_PLY = 128;
+
+/// Largest history value of a move. Once passed, the history of the color is
+/// halved, keeping the order of its moves.
+const int MAX_HISTORY = 1 << 24;
+
+/// Number of nodes searched between checks of the clock and cancel flag.
+const uint64_t LIMIT_CHECK_INTERVAL = 1024;
+
+/**
+ * Limits of a search. The search stops as soon as any limit is reached.
+ */
+struct SearchLimits {
+  /// Depth limit of the last iteration.
+  int depth = DEFAULT_DEPTH;
+
+  /// Number of nodes the calling thread may search, 0 for no limit.
+  uint64_t nodes = 0;
+
+  /// Time by which the search must stop, no limit if left at its maximum.
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::time_point::max();
+
+  /// Flag another thread sets to cancel the search, nullptr if none.
+  const std::atomic<bool> *cancel = nullptr;
+
+  /// Called while iterations run with the number of nodes searched by the
+  /// calling thread and the time since the search started, at most once per
+  /// `progress_interval`. Empty for no progress reports.
+  std::function<void(uint64_t, std::chrono::steady_clock::duration)> progress;
+
+  /// Least time between two calls of `progress`.
+  std::chrono::steady_clock::duration progress_interval =
+      std::chrono::seconds(1);
+};
+
+/**
+ * Progress of a search, reported after each completed iteration.
+ */
+struct SearchInfo {
+  /// Depth limit of the iteration.
+  int depth;
+
+  /// Score of the best move from the perspective of the searching color.
+  int score;
+
+  /// Number of nodes searched by the calling thread so far.
+  uint64_t nodes;
+
+  /// Time since the search started.
+  std::chrono::steady_clock::duration elapsed;
+
+  /// Best move followed by the expected line of play (principal variation).
+  std::vector<Move> pv;
+};
+
+/**
+ * State of one search thread, passed to every node it searches.
+ */
+struct SearchContext {
+  /**
+   * Constructs search context with no killer moves, history or counts.
+   *
+   * @param table Transposition table shared by every search thread.
+   * @param stop Flag set once the search is over.
+   * @param limits Limits checked by this thread, nullptr if none.
+   */
+  SearchContext(TranspositionTable *table, std::atomic<bool> *stop,
+                const SearchLimits *limits = nullptr);
+
+  /// Transposition table shared by every search thread.
+  TranspositionTable *table;
+
+  /// Set once the search is over, nodes return immediately without storing
+  /// their result. Set by the thread checking `limits` once one is reached.
+  std::atomic<bool> *stop;
+
+  /// Limits checked by this thread, nullptr for helper threads.
+  const SearchLimits *limits;
+
+  /// Counters of this thread, summed with other threads once the search is
+  /// over.
+  SearchStats stats;
+
+  /// Time the search of this thread started and `limits.progress` was last
+  /// called.
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point last_progress;
+
+  /// Number of moves played from the root to the node being searched.
+  int ply;
+
+  /// Quiet moves that last caused a cutoff, indexed by ply, most recent
+  /// first.
+  Move killers[MAX_PLY][MovePicker::KILLERS];
+
+  /// Ordering value of quiet moves, raised by the square of the remaining
+  /// depth whenever one causes a cutoff and kept below `MAX_HISTORY`.
+  /// Indexed by color, origin and destination square.
+  int history[2][64][64];
+};
+
+/**
+ * Finds best move using the assignment specified algorithm.
+ * This assignment is using Iterative-Deepening Depth-Limited MiniMax, with
+ * alpha-beta pruning.
+ * Uses a transposition table shared by every call.
+ *
+ * @param b Board to find move on.
+ * @param color Color to find move of.
+ * @return Move found using algorithm.
+ */
+Move find_move(const Board &b, Piece::Color color);
+
+/**
+ * Finds best move using the assignment specified algorithm, storing and
+ * reusing search results in the provided transposition table.
+ *
+ * With more than one thread, helper threads search the same position on their
+ * own board copies, starting at alternating depths and continuing past
+ * `depth`, and share results through `table` (Lazy SMP). The move found by
+ * the calling thread is returned, helpers stop once it finishes.
+ *
+ * @param b Board to find move on.
+ * @param color Color to find move of.
+ * @param table Transposition table to search with.
+ * @param depth Depth limit of last iteration.
+ * @param threads Number of search threads, including the calling thread.
+ * @return Move found using algorithm.
+ */
+Move find_move(const Board &b, Piece::Color color, TranspositionTable &table,
+               int depth = DEFAULT_DEPTH, int threads = 1);
+
+/**
+ * Finds best move within search limits, storing and reusing search results
+ * in the provided transposition table. Deepens one iteration at a time until
+ * `limits.depth` or until another limit stops the search, and returns the best
+ * move of the last completed iteration. If the first iteration does not
+ * complete, the best move it found so far is returned, or any valid move.
+ *
+ * Helper threads are used as in the overload taking a depth. Only the calling
+ * thread counts nodes against `limits.nodes`.
+ *
+ * @param b Board to find move on.
+ * @param color Color to find move of.
+ * @param table Transposition table to search with.
+ * @param limits Limits of search.
+ * @param threads Number of search threads, including the calling thread.
+ * @param report Called by the calling thread after each completed iteration,
+ * if set.
+ * @param stats Set to the statistics of the search, summed over every thread,
+ * if not nullptr.
+ * @return Move found using algorithm, empty move if `color` has no valid
+ * moves.
+ */
+Move find_move(const Board &b, Piece::Color color, TranspositionTable &table,
+               const SearchLimits &limits, int threads = 1,
+               const std::function<void(const SearchInfo &)> &report = nullptr,
+               SearchStats *stats = nullptr);
+
+/**
+ * Limits a score to the range reported to users and other programs.
+ *
+ * @param score Score of a search.
+ * @return `score` clamped to +/- `MAX_REPORTED_SCORE`.
+ */
+int reported_score(int score);
+
+/**
+ * Obtains the line of play expected after a move, by following the moves
+ * stored in the transposition table. Stops at the first position without a
+ * valid stored move.
+ *
+ * @param b Board to play line on.
+ * @param move First move of line, valid on `b`.
+ * @param table Transposition table to follow.
+ * @param length Maximum number of moves in line, including `move`.
+ * @return Moves of line, starting with `move`.
+ */
+std::vector<Move> principal_variation(const Board &b, const Move &move,
+                                      const TranspositionTable &table,
+                                      int length);
+
+/**
+ * Find the best move at the current depth limit.
+ *
+ * @param b Board to find move on.
+ * @param color Color to find move of.
+ * @param depth Current depth limit.
+ * @param context State of searching thread.
+ * @return Pair of move and int score of best move.
+ */
+std::pair<Move, int> max_choice(Board &b, Piece::Color color, int depth,
+                                SearchContext &context);
+
+/**
+ * Find the best move for other color at the current depth limit.
+ *
+ * @param b Board to find move on.
+ * @param color Color to find move of.
+ * @param depth Current depth limit.
+ * @param alpha Score `color` is already assured of.
+ * @param beta Score other color is already assured of.
+ * @param context State of searching thread.
+ * @return Int score of best move.
+ */
+int min_value(Board &b, Piece::Color color, int depth, int alpha, int beta,
+              SearchContext &context);
+
+/**
+ * Find the best move at the current depth limit.
+ *
+ * @param b Board to find move on.
+ * @param color Color to find move of.
+ * @param depth Current depth limit.
+ * @param alpha Score `color` is already assured of.
+ * @param beta Score other color is already assured of.
+ * @param context State of searching thread.
+ * @return Int score of best move.
+ */
+int max_value(Board &b, Piece::Color color, int depth, int alpha, int beta,
+              SearchContext &context);
+
+/**
+ * Find the score for other color once the depth limit is reached, searching
+ * only captures that do not lose material until the position is quiet. Other
+ * color may instead stand pat on the static score, and captures that cannot
+ * bring the score below `beta` are skipped (delta pruning).
+ *
+ * @param b Board to find move on.
+ * @param color Color to find move of.
+ * @param alpha Score `color` is already assured of.
+ * @param beta Score other color is already assured of.
+ * @param context State of searching thread.
+ * @return Int score of position.
+ */
+int min_quiescence(Board &b, Piece::Color color, int alpha, int beta,
+                   SearchContext &context);
+
+/**
+ * Find the score once the depth limit is reached, searching only captures
+ * that do not lose material until the position is quiet. `color` may instead
+ * stand pat on the static score, and captures that cannot raise the score
+ * above `alpha` are skipped (delta pruning).
+ *
+ * @param b Board to find move on.
+ * @param color Color to find move of.
+ * @param alpha Score `color` is already assured of.
+ * @param beta Score other color is already assured of.
+ * @param context State of searching thread.
+ * @return Int score of position.
+ */
+int max_quiescence(Board &b, Piece::Color color, int alpha, int beta,
+                   SearchContext &context);
+
+#endif
\ No newline at end of file
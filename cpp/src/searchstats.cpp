@@ -0,0 +1,76 @@
+#include "searchstats.h"
+
+/**
+ * Divides two counters.
+ *
+ * @param numerator Counter to divide.
+ * @param denominator Counter to divide by.
+ * @return Quotient, 0 if `denominator` is 0.
+ */
+static double ratio(const uint64_t numerator, const uint64_t denominator) {
+  return denominator == 0 ? 0.0 : double(numerator) / double(denominator);
+}
+
+/**
+ * Converts a duration to milliseconds.
+ *
+ * @param duration Duration to convert.
+ * @return Milliseconds of `duration`, with fraction.
+ */
+static double milliseconds(
+    const std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+SearchStats &SearchStats::operator+=(const SearchStats &stats) {
+  nodes += stats.nodes;
+  quiescence_nodes += stats.quiescence_nodes;
+  expanded_nodes += stats.expanded_nodes;
+  moves_searched += stats.moves_searched;
+  cutoffs += stats.cutoffs;
+  first_move_cutoffs += stats.first_move_cutoffs;
+  table_probes += stats.table_probes;
+  table_hits += stats.table_hits;
+  table_cutoffs += stats.table_cutoffs;
+  return *this;
+}
+
+double SearchStats::branching_factor() const {
+  return ratio(moves_searched, expanded_nodes);
+}
+
+double SearchStats::cutoff_rate() const {
+  return ratio(cutoffs, expanded_nodes);
+}
+
+double SearchStats::first_move_cutoff_rate() const {
+  return ratio(first_move_cutoffs, cutoffs);
+}
+
+double SearchStats::table_hit_rate() const {
+  return ratio(table_hits, table_probes);
+}
+
+std::ostream &write_json(std::ostream &os, const SearchStats &stats) {
+  double time = milliseconds(stats.elapsed);
+  os << "{\"threads\":" << stats.threads << ",\"time_ms\":" << time
+     << ",\"nodes\":" << stats.nodes
+     << ",\"nps\":" << (time > 0 ? uint64_t(stats.nodes * 1000 / time) : 0)
+     << ",\"quiescence_nodes\":" << stats.quiescence_nodes
+     << ",\"expanded_nodes\":" << stats.expanded_nodes
+     << ",\"branching_factor\":" << stats.branching_factor()
+     << ",\"cutoffs\":" << stats.cutoffs
+     << ",\"cutoff_rate\":" << stats.cutoff_rate()
+     << ",\"first_move_cutoff_rate\":" << stats.first_move_cutoff_rate()
+     << ",\"table_probes\":" << stats.table_probes
+     << ",\"table_hits\":" << stats.table_hits
+     << ",\"table_hit_rate\":" << stats.table_hit_rate()
+     << ",\"table_cutoffs\":" << stats.table_cutoffs << ",\"iterations\":[";
+  for (size_t i = 0; i < stats.iterations.size(); ++i) {
+    const IterationStats &iteration = stats.iterations[i];
+    os << (i == 0 ? "" : ",") << "{\"depth\":" << iteration.depth
+       << ",\"nodes\":" << iteration.nodes
+       << ",\"time_ms\":" << milliseconds(iteration.elapsed) << "}";
+  }
+  return os << "]}";
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * Statistics of one completed iteration of a search, from the calling
+ * thread.
+ */
+struct IterationStats {
+  /// Depth limit of the iteration.
+  int depth;
+
+  /// Number of nodes searched during the iteration.
+  uint64_t nodes;
+
+  /// Time spent on the iteration.
+  std::chrono::steady_clock::duration elapsed;
+};
+
+/**
+ * Counters of a search. Each search thread counts into its own copy, so
+ * counting needs no synchronization, and the copies are summed once the
+ * threads are done.
+ */
+struct SearchStats {
+  /// Number of nodes searched, including quiescence nodes.
+  uint64_t nodes = 0;
+
+  /// Number of nodes searched by quiescence search.
+  uint64_t quiescence_nodes = 0;
+
+  /// Number of nodes above the depth limit whose moves were searched.
+  uint64_t expanded_nodes = 0;
+
+  /// Number of moves searched from expanded nodes.
+  uint64_t moves_searched = 0;
+
+  /// Number of expanded nodes left early because a move caused a cutoff.
+  uint64_t cutoffs = 0;
+
+  /// Number of cutoffs caused by the first move searched.
+  uint64_t first_move_cutoffs = 0;
+
+  /// Number of transposition table probes.
+  uint64_t table_probes = 0;
+
+  /// Number of probes that found an entry for the position.
+  uint64_t table_hits = 0;
+
+  /// Number of hits whose stored score was returned without searching.
+  uint64_t table_cutoffs = 0;
+
+  /// Number of search threads.
+  int threads = 1;
+
+  /// Time from start to end of the search.
+  std::chrono::steady_clock::duration elapsed =
+      std::chrono::steady_clock::duration::zero();
+
+  /// Iterations completed by the calling thread, in order.
+  std::vector<IterationStats> iterations;
+
+  /**
+   * Adds the counters of another thread or search. Iterations, threads and
+   * time are kept.
+   *
+   * @param stats Counters to add.
+   * @return Reference to this object.
+   */
+  SearchStats &operator+=(const SearchStats &stats);
+
+  /**
+   * Obtains the average number of moves searched per expanded node.
+   *
+   * @return Branching factor, 0 if no node was expanded.
+   */
+  double branching_factor() const;
+
+  /**
+   * Obtains the share of expanded nodes left early by a cutoff.
+   *
+   * @return Cutoff rate between 0 and 1.
+   */
+  double cutoff_rate() const;
+
+  /**
+   * Obtains the share of cutoffs caused by the first move searched, a measure
+   * of move ordering.
+   *
+   * @return First move cutoff rate between 0 and 1.
+   */
+  double first_move_cutoff_rate() const;
+
+  /**
+   * Obtains the share of transposition table probes finding an entry.
+   *
+   * @return Hit rate between 0 and 1.
+   */
+  double table_hit_rate() const;
+};
+
+/**
+ * Outputs statistics as a single line JSON object, without newline. Times are
+ * in milliseconds.
+ *
+ * @param os Stream to output to.
+ * @param stats Statistics to output.
+ * @return Reference to `os`.
+ */
+std::ostream &write_json(std::ostream &os, const SearchStats &stats);
+
+#endif
\ No newline at end of file
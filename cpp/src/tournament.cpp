@@ -0,0 +1,246 @@
+#include "tournament.h"
+
+#include "board.h"
+#include "move.h"
+#include "pgn.h"
+#include "transposition.h"
+#include "util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// Size of the transposition table of each player of a game, in megabytes.
+static const int PLAYER_TABLE_SIZE = 4;
+
+/**
+ * Results of a tournament so far, shared by every worker.
+ */
+struct TournamentState {
+  /// Guards every member and both output streams.
+  std::mutex mutex;
+
+  /// Index of the next game to play.
+  std::atomic<int> next_game{0};
+
+  /// Date the tournament started, for the Date tag.
+  std::string date;
+
+  /// Games won by player A, drawn and lost by player A.
+  int wins = 0;
+  int draws = 0;
+  int losses = 0;
+};
+
+/**
+ * Names a player by its search budget, e.g. "A (depth 4, movetime 100)".
+ *
+ * @param letter Letter of player.
+ * @param budget Search budget of player.
+ * @return Name of player.
+ */
+static std::string player_name(const char letter, const MoveBudget &budget) {
+  std::string name = std::string(1, letter) + " (depth " +
+                     std::to_string(budget.depth);
+  if (budget.nodes != 0) {
+    name += ", nodes " + std::to_string(budget.nodes);
+  }
+  if (budget.move_time != 0) {
+    name += ", movetime " + std::to_string(budget.move_time);
+  }
+  return name + ")";
+}
+
+/**
+ * Plays one game to its end.
+ *
+ * @param fen FEN string of start position.
+ * @param budgets Search budget of white then black.
+ * @param tables Transposition table of white then black, cleared first.
+ * @param game Moves and result of game are set.
+ * @return Reason the game ended, for the Termination tag.
+ */
+static std::string play_game(const std::string &fen,
+                             const MoveBudget *budgets[2],
+                             TranspositionTable *tables[2], PgnGame &game) {
+  tables[0]->clear();
+  tables[1]->clear();
+  Board board(fen);
+  for (int ply = 0;; ++ply) {
+    Piece::Color color = board.get_current_move();
+    if (board.checkmated(color)) {
+      game.result = color == Piece::Color::WHITE ? "0-1" : "1-0";
+      return "normal";
+    }
+    if (board.stalemated(color) || board.draw()) {
+      game.result = "1/2-1/2";
+      return "normal";
+    }
+    if (ply >= MAX_GAME_PLIES) {
+      game.result = "1/2-1/2";
+      return "adjudication";
+    }
+
+    const MoveBudget &budget = *budgets[int(color)];
+    SearchLimits limits;
+    limits.depth = budget.depth;
+    limits.nodes = budget.nodes;
+    if (budget.move_time > 0) {
+      limits.deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(budget.move_time);
+    }
+    Move move = find_move(board, color, *tables[int(color)], limits);
+    game.moves.push_back(move);
+    board.make_move(move);
+  }
+}
+
+/**
+ * Plays games of the tournament until every game has been taken.
+ *
+ * @param openings FEN string of each start position.
+ * @param budgets Search budget of player A then B.
+ * @param games Number of games.
+ * @param state Results shared with other workers.
+ * @param pgn Stream to output games to.
+ * @param log Stream to output progress to.
+ */
+static void tournament_worker(const std::vector<std::string> &openings,
+                              const MoveBudget *budgets, const int games,
+                              TournamentState &state, std::ostream &pgn,
+                              std::ostream &log) {
+  TranspositionTable tables[2] = {TranspositionTable(PLAYER_TABLE_SIZE),
+                                  TranspositionTable(PLAYER_TABLE_SIZE)};
+  for (int index = state.next_game++; index < games;
+       index = state.next_game++) {
+    // Each start position is played twice in a row, with colors swapped.
+    const std::string &fen = openings[(index / 2) % openings.size()];
+    int white = index % 2, black = white ^ 1;
+    const MoveBudget *game_budgets[2] = {&budgets[white], &budgets[black]};
+    TranspositionTable *game_tables[2] = {&tables[white], &tables[black]};
+
+    PgnGame game;
+    std::string termination = play_game(fen, game_budgets, game_tables, game);
+
+    std::string names[2] = {player_name('A', budgets[0]),
+                            player_name('B', budgets[1])};
+    game.tags = {{"Event", "Tournament"},
+                 {"Site", "?"},
+                 {"Date", state.date},
+                 {"Round", std::to_string(index + 1)},
+                 {"White", names[white]},
+                 {"Black", names[black]},
+                 {"Result", game.result}};
+    if (fen != Board::START_FEN) {
+      game.tags.push_back({"SetUp", "1"});
+      game.tags.push_back({"FEN", fen});
+    }
+    game.tags.push_back({"Termination", termination});
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    write_pgn(pgn, game);
+    if (game.result == "1/2-1/2") {
+      ++state.draws;
+    } else if ((game.result == "1-0") == (white == 0)) {
+      ++state.wins;
+    } else {
+      ++state.losses;
+    }
+    log << "Finished game " << index + 1 << " (" << names[white] << " vs "
+        << names[black] << "): " << game.result << " {" << termination << "}"
+        << std::endl;
+  }
+}
+
+/**
+ * Converts an expected score into an Elo rating difference. The score is kept
+ * half a game away from 0 and 1, so a one-sided match gives a finite bound.
+ *
+ * @param score Expected score, between 0 and 1.
+ * @param played Number of games the score is measured over.
+ * @return Elo difference.
+ */
+static double elo_difference(double score, const int played) {
+  double limit = 0.5 / played;
+  score = std::max(limit, std::min(1.0 - limit, score));
+  return 400.0 * std::log10(score / (1.0 - score));
+}
+
+std::vector<std::string> read_openings(std::istream &in, std::ostream &log) {
+  std::vector<std::string> openings;
+  std::string line;
+  Board board;
+  while (std::getline(in, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    if (board.set_fen(line) != FenError::NONE &&
+        board.set_fen(epd_position(line)) != FenError::NONE) {
+      log << "invalid position: " << line << std::endl;
+      continue;
+    }
+    openings.push_back(board.to_fen());
+  }
+  return openings;
+}
+
+void run_tournament(const std::vector<std::string> &openings,
+                    const MoveBudget &budget_a, const MoveBudget &budget_b,
+                    int games, int workers, std::ostream &pgn,
+                    std::ostream &log) {
+  auto start = std::chrono::steady_clock::now();
+  const MoveBudget budgets[2] = {budget_a, budget_b};
+  TournamentState state;
+  char date[11];
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y.%m.%d", std::localtime(&now));
+  state.date = date;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < std::max(1, std::min(workers, games)); ++i) {
+    threads.push_back(std::thread(tournament_worker, std::cref(openings),
+                                  budgets, games, std::ref(state),
+                                  std::ref(pgn), std::ref(log)));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  pgn.flush();
+
+  // Error bars from the variance of the score of each game, 95% confidence.
+  int played = state.wins + state.draws + state.losses;
+  if (played == 0) {
+    return;
+  }
+  double score = (state.wins + 0.5 * state.draws) / played;
+  double variance = (state.wins * std::pow(1.0 - score, 2) +
+                     state.draws * std::pow(0.5 - score, 2) +
+                     state.losses * std::pow(score, 2)) /
+                    played;
+  double margin = 1.96 * std::sqrt(variance / played);
+  double hours =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count() /
+      3600;
+
+  log << "Score of " << player_name('A', budget_a) << " vs "
+      << player_name('B', budget_b) << ": " << state.wins << " - "
+      << state.losses << " - " << state.draws << " [" << score << "] "
+      << played << std::endl;
+  log << "Elo difference: " << elo_difference(score, played) << " +/- "
+      << (elo_difference(score + margin, played) -
+          elo_difference(score - margin, played)) /
+             2
+      << std::endl;
+  log << played / hours << " games/hour" << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include "search.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Number of plies after which a game is adjudicated a draw.
+const int MAX_GAME_PLIES = 400;
+
+/**
+ * Search budget of each move of a tournament player.
+ */
+struct MoveBudget {
+  /// Depth limit of the last iteration.
+  int depth = DEFAULT_DEPTH;
+
+  /// Number of nodes each search may use, 0 for no limit.
+  uint64_t nodes = 0;
+
+  /// Milliseconds each search may use, 0 for no limit.
+  int move_time = 0;
+};
+
+/**
+ * Reads the start positions of a tournament, one FEN or EPD line each. Empty
+ * lines and lines starting with '#' are skipped, lines that are not valid
+ * positions are reported to `log` and skipped.
+ *
+ * @param in Stream to read positions from.
+ * @param log Stream to report invalid lines to.
+ * @return FEN string of each valid position, in input order.
+ */
+std::vector<std::string> read_openings(std::istream &in, std::ostream &log);
+
+/**
+ * Plays a tournament between two players, the engine searching with budget
+ * A and with budget B, on a pool of worker threads. Each game is played on
+ * its own board, with a transposition table per player cleared before the
+ * game. Games cycle through the start positions, each played twice so both
+ * players get each color.
+ *
+ * Games end by checkmate, stalemate or `Board::draw`, or are adjudicated a
+ * draw after `MAX_GAME_PLIES` plies. Each game is output in PGN as it
+ * finishes, then a summary of the score of A, the Elo difference with its
+ * 95% error bars, and games per hour is output to `log`.
+ *
+ * @param openings FEN string of each start position, at least one.
+ * @param budget_a Search budget of player A.
+ * @param budget_b Search budget of player B.
+ * @param games Number of games.
+ * @param workers Number of games played at once.
+ * @param pgn Stream to output games to.
+ * @param log Stream to output progress and summary to.
+ */
+void run_tournament(const std::vector<std::string> &openings,
+                    const MoveBudget &budget_a, const MoveBudget &budget_b,
+                    int games, int workers, std::ostream &pgn,
+                    std::ostream &log);
+
+#endif
\ No newline at end of file
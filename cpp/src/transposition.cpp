@@ -0,0 +1,98 @@
+#include "transposition.h"
+
+#include <algorithm>
+
+/**
+ * Getters for the fields packed in `Slot::data`.
+ */
+static int data_depth(const uint64_t data) { return int8_t(data >> 48); }
+static int data_generation(const uint64_t data) { return int(data >> 58); }
+
+void TranspositionTable::resize(const size_t megabytes) {
+  size_t clusters = 1;
+  while (clusters * 2 * sizeof(Cluster) <= megabytes * 1024 * 1024) {
+    clusters *= 2;
+  }
+  m_clusters.reset(new Cluster[clusters]);
+  m_cluster_count = clusters;
+  clear();
+}
+
+void TranspositionTable::clear() {
+  for (size_t i = 0; i < m_cluster_count; ++i) {
+    for (Slot &slot : m_clusters[i].slots) {
+      slot.key.store(0, std::memory_order_relaxed);
+      slot.data.store(0, std::memory_order_relaxed);
+    }
+  }
+  m_generation = 0;
+}
+
+bool TranspositionTable::probe(const uint64_t key, Entry &entry) const {
+  for (const Slot &slot : cluster(key).slots) {
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    if ((slot.key.load(std::memory_order_relaxed) ^ data) == key &&
+        data != 0) {
+      entry.move = Move(uint16_t(data));
+      entry.score = int32_t(data >> 16);
+      entry.depth = data_depth(data);
+      entry.bound = Bound((data >> 56) & 0x3);
+      return true;
+    }
+  }
+  return false;
+}
+
+void TranspositionTable::store(const uint64_t key, const int depth,
+                               const Bound bound, const int score,
+                               const Move &move) {
+  // Reuse the slot of the same position or an empty slot. Otherwise replace
+  // the slot with the lowest depth, counting each generation of age as 8
+  // plies of depth so entries of old searches are replaced first.
+  Slot *replace = nullptr;
+  uint64_t replace_data = 0;
+  bool same_position = false;
+  int replace_value = INT32_MAX;
+  for (Slot &slot : cluster(key).slots) {
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    same_position = (slot.key.load(std::memory_order_relaxed) ^ data) == key;
+    if (same_position || data == 0) {
+      replace = &slot;
+      replace_data = data;
+      break;
+    }
+    int age = (m_generation - data_generation(data)) & GENERATION_MASK;
+    int value = data_depth(data) - 8 * age;
+    if (value < replace_value) {
+      replace = &slot;
+      replace_data = data;
+      replace_value = value;
+    }
+  }
+
+  // Keep the stored best move of the position if no new best move was found.
+  uint64_t packed_move = move.get_data();
+  if (packed_move == 0 && same_position) {
+    packed_move = replace_data & 0xFFFF;
+  }
+
+  uint64_t data = packed_move | uint64_t(uint32_t(score)) << 16 |
+                  uint64_t(uint8_t(depth)) << 48 | uint64_t(bound) << 56 |
+                  uint64_t(m_generation) << 58;
+  replace->data.store(data, std::memory_order_relaxed);
+  replace->key.store(key ^ data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+  size_t samples = std::min(m_cluster_count, size_t(1000));
+  int used = 0;
+  for (size_t i = 0; i < samples; ++i) {
+    for (const Slot &slot : m_clusters[i].slots) {
+      uint64_t data = slot.data.load(std::memory_order_relaxed);
+      if (data != 0 && data_generation(data) == m_generation) {
+        ++used;
+      }
+    }
+  }
+  return int(used * 1000 / (samples * CLUSTER_SIZE));
+}
\ No newline at end of file
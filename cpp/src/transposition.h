@@ -0,0 +1,142 @@
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include "move.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Transposition table class. Fixed size, power of two hash table of search
+ * results keyed by board Zobrist key. Probing and storing are lock-free, so
+ * one table can be shared by several search threads.
+ */
+class TranspositionTable {
+public:
+  /// Bound type of a stored score.
+  enum class Bound { NONE, EXACT, LOWER, UPPER };
+
+  /**
+   * Unpacked search result stored for a position.
+   */
+  struct Entry {
+    /// Best move found in position.
+    Move move;
+
+    /// Score of position from the perspective of the color to move.
+    int score;
+
+    /// Remaining depth the position was searched to.
+    int depth;
+
+    /// Whether `score` is exact or a lower or upper bound.
+    Bound bound;
+  };
+
+  /**
+   * Constructs transposition table with the given size.
+   *
+   * @param megabytes Size of table, rounded down to a power of two entries.
+   */
+  TranspositionTable(const size_t megabytes = 16) { resize(megabytes); }
+
+  /**
+   * Resizes the table, discarding all stored entries. Must not be called
+   * while a search is running.
+   *
+   * @param megabytes Size of table, rounded down to a power of two entries.
+   */
+  void resize(const size_t megabytes);
+
+  /**
+   * Discards all stored entries.
+   */
+  void clear();
+
+  /**
+   * Starts a new search. Entries from earlier searches are aged so they are
+   * replaced before entries of the current search. Must be called before the
+   * search threads are started.
+   */
+  void new_search() { m_generation = (m_generation + 1) & GENERATION_MASK; }
+
+  /**
+   * Finds the stored result of a position.
+   *
+   * @param key Zobrist key of position.
+   * @param entry Entry to fill with stored result.
+   * @return Boolean value if position was found.
+   */
+  bool probe(const uint64_t key, Entry &entry) const;
+
+  /**
+   * Stores the search result of a position. Replaces the entry of the same
+   * position, otherwise the shallowest and oldest entry of its cluster.
+   *
+   * @param key Zobrist key of position.
+   * @param depth Remaining depth position was searched to.
+   * @param bound Bound type of `score`.
+   * @param score Score of position from the perspective of the color to move.
+   * @param move Best move found in position.
+   */
+  void store(const uint64_t key, const int depth, const Bound bound,
+             const int score, const Move &move);
+
+  /**
+   * Estimates how full the table is from a sample of clusters.
+   *
+   * @return Permille of sampled entries used by the current search.
+   */
+  int hashfull() const;
+
+private:
+  /// Number of entries in a cluster, one cluster fills a cache line.
+  static const int CLUSTER_SIZE = 4;
+
+  /// Generations wrap around within the 6 bits stored in an entry.
+  static const int GENERATION_MASK = 0x3F;
+
+  /**
+   * Stored entry. `data` packs move (16 bits), score (32 bits), depth (8 bits),
+   * bound (2 bits) and generation (6 bits). The two words are written without
+   * a lock, so the key is stored xor `data`: a slot torn by concurrent stores
+   * no longer matches the key of either position.
+   */
+  struct Slot {
+    /// Full Zobrist key of stored position xor `data`, checked on probe.
+    std::atomic<uint64_t> key;
+
+    /// Packed search result.
+    std::atomic<uint64_t> data;
+  };
+
+  /**
+   * Entries sharing one table index.
+   */
+  struct alignas(64) Cluster {
+    Slot slots[CLUSTER_SIZE];
+  };
+
+  /// Table storage.
+  std::unique_ptr<Cluster[]> m_clusters;
+
+  /// Number of clusters in table, a power of two.
+  size_t m_cluster_count;
+
+  /// Generation of current search.
+  int m_generation;
+
+  /**
+   * Finds the cluster of a position.
+   *
+   * @param key Zobrist key of position.
+   * @return Reference to cluster `key` maps to.
+   */
+  Cluster &cluster(const uint64_t key) const {
+    return m_clusters[key & (m_cluster_count - 1)];
+  }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include "uci.h"
+
+#include "board.h"
+#include "move.h"
+#include "search.h"
+#include "transposition.h"
+#include "util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+/// Bounds of the Hash option, in megabytes.
+static const int DEFAULT_HASH = 16;
+static const int MAX_HASH = 65536;
+
+/// Bounds of the Threads option.
+static const int MAX_THREADS = 256;
+
+/// Depth limit of searches bounded only by time, nodes or `stop`.
+static const int MAX_DEPTH = 64;
+
+/// Moves assumed left until the next time control if `go` gives none.
+static const int DEFAULT_MOVES_TO_GO = 30;
+
+/// Time kept back from the clock for stopping the search and answering, in
+/// milliseconds.
+static const int MOVE_OVERHEAD = 20;
+
+/**
+ * State of a UCI session, shared by the command loop and the search thread.
+ */
+struct UciSession {
+  /**
+   * Constructs session in the starting position.
+   *
+   * @param out Stream to output to.
+   */
+  UciSession(std::ostream &out)
+      : out(out), board(), table(DEFAULT_HASH), threads(1), stats(false),
+        cancel(false), infinite(false) {}
+
+  /// Stream to output to, only written while holding `out_mutex`.
+  std::ostream &out;
+  std::mutex out_mutex;
+
+  /// Position set by the last `position` command.
+  Board board;
+
+  /// Transposition table kept between searches, cleared on `ucinewgame`.
+  TranspositionTable table;
+
+  /// Number of search threads.
+  int threads;
+
+  /// True if statistics are output as JSON after each search.
+  bool stats;
+
+  /// Thread running the current search, not joinable if none.
+  std::thread worker;
+
+  /// Set to stop the current search.
+  std::atomic<bool> cancel;
+
+  /// True if the current search must wait for `stop` before answering.
+  bool infinite;
+};
+
+/**
+ * Outputs a line as one write, so lines of the command loop and the search
+ * thread never interleave.
+ *
+ * @param session Session to output to.
+ * @param line Line to output, without newline.
+ */
+static void send(UciSession &session, const std::string &line) {
+  std::lock_guard<std::mutex> lock(session.out_mutex);
+  session.out << line << std::endl;
+}
+
+/**
+ * Stops the current search, if any, and waits for its best move to be output.
+ *
+ * @param session Session to stop search of.
+ */
+static void stop_search(UciSession &session) {
+  session.cancel.store(true, std::memory_order_relaxed);
+  if (session.worker.joinable()) {
+    session.worker.join();
+  }
+}
+
+/**
+ * Formats the info line of a completed iteration.
+ *
+ * @param info Progress of search.
+ * @return UCI info line.
+ */
+static std::string info_line(const SearchInfo &info) {
+  long long milliseconds =
+      std::chrono::duration_cast<std::chrono::milliseconds>(info.elapsed)
+          .count();
+  int score = reported_score(info.score);
+
+  std::ostringstream line;
+  line << "info depth " << info.depth << " score cp " << score << " nodes "
+       << info.nodes << " nps "
+       << info.nodes * 1000 / std::max(milliseconds, 1LL) << " time "
+       << milliseconds << " pv";
+  for (const Move &move : info.pv) {
+    line << ' ' << move_to_uci(move);
+  }
+  return line.str();
+}
+
+/**
+ * Formats the info line of a search in progress, between completed
+ * iterations.
+ *
+ * @param nodes Number of nodes searched so far.
+ * @param elapsed Time since the search started.
+ * @return UCI info line.
+ */
+static std::string progress_line(const uint64_t nodes,
+                                 const std::chrono::steady_clock::duration
+                                     elapsed) {
+  long long milliseconds =
+      std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+  return "info nodes " + std::to_string(nodes) + " nps " +
+         std::to_string(nodes * 1000 / std::max(milliseconds, 1LL)) +
+         " time " + std::to_string(milliseconds);
+}
+
+/**
+ * Rejects the position of a `position` command. The board is left without
+ * pieces, so a following `go` answers `bestmove 0000` instead of searching
+ * the previous position.
+ *
+ * @param session Session to reset position of.
+ * @param reason Reason position was rejected, output as an info string.
+ */
+static void reject_position(UciSession &session, const std::string &reason) {
+  session.board.set_fen(Board::EMPTY_FEN);
+  send(session, "info string " + reason);
+}
+
+/**
+ * Handles `position [startpos | fen <fen>] [moves <move>...]`. An invalid
+ * position or move rejects the whole command.
+ *
+ * @param session Session to set position of.
+ * @param args Arguments of command.
+ */
+static void set_position(UciSession &session, std::istringstream &args) {
+  std::string token, fen;
+  args >> token;
+  if (token == "startpos") {
+    fen = Board::START_FEN;
+    args >> token;
+  } else if (token == "fen") {
+    while (args >> token && token != "moves") {
+      fen += (fen.empty() ? "" : " ") + token;
+    }
+  } else {
+    reject_position(session, "invalid position " + token);
+    return;
+  }
+  if (session.board.set_fen(fen) != FenError::NONE) {
+    reject_position(session, "invalid fen " + fen);
+    return;
+  }
+
+  while (args >> token) {
+    const Piece *piece =
+        token.length() < 4
+            ? nullptr
+            : session.board.piece_at(uci_to_coordinate(token.substr(0, 2)));
+    if (piece == nullptr) {
+      reject_position(session, "invalid move " + token);
+      return;
+    }
+    Move move = uci_to_move(token, piece->get_type(),
+                            session.board.get_empassant_target());
+    MoveList moves;
+    session.board.get_moves(session.board.get_current_move(), moves);
+    if (std::none_of(moves.begin(), moves.end(), [&move](const Move &valid) {
+          return valid.get_data() == move.get_data();
+        })) {
+      reject_position(session, "invalid move " + token);
+      return;
+    }
+    session.board.make_move(move);
+  }
+}
+
+/**
+ * Handles `setoption name <name> value <value>` for Hash, Threads and Stats.
+ *
+ * @param session Session to set option of.
+ * @param args Arguments of command.
+ */
+static void set_option(UciSession &session, std::istringstream &args) {
+  std::string token, name, value;
+  args >> token;
+  while (args >> token && token != "value") {
+    name += (name.empty() ? "" : " ") + token;
+  }
+  args >> value;
+  if (value.empty()) {
+    return;
+  }
+
+  int number = std::atoi(value.c_str());
+  if (name == "Hash") {
+    session.table.resize(std::max(1, std::min(MAX_HASH, number)));
+  } else if (name == "Threads") {
+    session.threads = std::max(1, std::min(MAX_THREADS, number));
+  } else if (name == "Stats") {
+    session.stats = value == "true";
+  }
+}
+
+/**
+ * Handles `go` and starts searching on the worker thread. An info line is
+ * output after each iteration, and an `info nodes` line every second while
+ * one runs. The best move is output once a limit is reached, or on `stop`
+ * when searching infinite. An explicit `infinite` ignores the clock and move
+ * time, depth and nodes still end the search early but the answer waits for
+ * `stop`. With the Stats option set, the statistics of the search are output
+ * before it as `info string stats <json>`.
+ *
+ * @param session Session to search position of.
+ * @param args Arguments of command.
+ */
+static void go(UciSession &session, std::istringstream &args) {
+  auto start = std::chrono::steady_clock::now();
+  Piece::Color color = session.board.get_current_move();
+  SearchLimits limits;
+  limits.depth = MAX_DEPTH;
+  limits.cancel = &session.cancel;
+  limits.progress = [&session](uint64_t nodes,
+                               std::chrono::steady_clock::duration elapsed) {
+    send(session, progress_line(nodes, elapsed));
+  };
+  long long time_left = -1, increment = 0, move_time = -1;
+  int moves_to_go = DEFAULT_MOVES_TO_GO;
+  bool infinite = false, limited = false;
+
+  std::string token;
+  while (args >> token) {
+    long long value = 0;
+    if (token == "infinite") {
+      infinite = true;
+      continue;
+    }
+    if (token == "ponder") {
+      continue;
+    }
+    args >> value;
+    if ((token == "wtime" && color == Piece::Color::WHITE) ||
+        (token == "btime" && color == Piece::Color::BLACK)) {
+      time_left = value;
+    } else if ((token == "winc" && color == Piece::Color::WHITE) ||
+               (token == "binc" && color == Piece::Color::BLACK)) {
+      increment = value;
+    } else if (token == "movestogo" && value > 0) {
+      moves_to_go = int(value);
+    } else if (token == "movetime") {
+      move_time = value;
+    } else if (token == "depth") {
+      limits.depth = std::max(1, std::min(MAX_DEPTH, int(value)));
+      limited = true;
+    } else if (token == "nodes") {
+      limits.nodes = uint64_t(std::max(1LL, value));
+      limited = true;
+    }
+  }
+
+  // Spend an even share of the clock per move, keeping the overhead back.
+  if (move_time < 0 && time_left >= 0) {
+    move_time = std::min(time_left / moves_to_go + increment / 2,
+                         time_left - MOVE_OVERHEAD);
+  } else if (move_time >= 0) {
+    move_time -= MOVE_OVERHEAD;
+  }
+  if (!infinite && (move_time >= 0 || time_left >= 0)) {
+    limits.deadline =
+        start + std::chrono::milliseconds(std::max(1LL, move_time));
+    limited = true;
+  }
+
+  session.cancel.store(false, std::memory_order_relaxed);
+  session.infinite = infinite || !limited;
+  Board board(session.board);
+  int threads = session.threads;
+  bool output_stats = session.stats;
+  session.worker = std::thread([&session, board, limits, threads,
+                                output_stats]() {
+    SearchStats stats;
+    Move move = find_move(
+        board, board.get_current_move(), session.table, limits, threads,
+        [&session](const SearchInfo &info) { send(session, info_line(info)); },
+        output_stats ? &stats : nullptr);
+    if (output_stats) {
+      std::ostringstream line;
+      write_json(line << "info string stats ", stats);
+      send(session, line.str());
+    }
+
+    // An infinite search only answers once stopped.
+    while (session.infinite &&
+           !session.cancel.load(std::memory_order_relaxed)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    send(session, "bestmove " + (move == Move() ? std::string("0000")
+                                                : move_to_uci(move)));
+  });
+}
+
+void uci_loop(std::istream &in, std::ostream &out) {
+  UciSession session(out);
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream args(line);
+    std::string command;
+    args >> command;
+
+    if (command == "uci") {
+      send(session, "id name chess");
+      send(session, "id author CalebHock");
+      send(session, "option name Hash type spin default " +
+                        std::to_string(DEFAULT_HASH) + " min 1 max " +
+                        std::to_string(MAX_HASH));
+      send(session, "option name Threads type spin default 1 min 1 max " +
+                        std::to_string(MAX_THREADS));
+      send(session, "option name Stats type check default false");
+      send(session, "uciok");
+    } else if (command == "isready") {
+      send(session, "readyok");
+    } else if (command == "ucinewgame") {
+      stop_search(session);
+      session.table.clear();
+    } else if (command == "position") {
+      stop_search(session);
+      set_position(session, args);
+    } else if (command == "go") {
+      stop_search(session);
+      go(session, args);
+    } else if (command == "stop") {
+      stop_search(session);
+    } else if (command == "setoption") {
+      stop_search(session);
+      set_option(session, args);
+    } else if (command == "quit") {
+      break;
+    }
+  }
+  stop_search(session);
+}
\ No newline at end of file
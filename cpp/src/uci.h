@@ -0,0 +1,20 @@
+#ifndef UCI_H
+#define UCI_H
+
+#include <iostream>
+
+/**
+ * Runs the engine over the Universal Chess Interface (UCI) protocol. Reads
+ * commands from `in` until `quit` or the end of input. Searches run on a
+ * worker thread, so commands such as `isready` and `stop` are answered while
+ * searching.
+ *
+ * Supported commands: `uci`, `isready`, `ucinewgame`, `position`, `go`,
+ * `stop`, `setoption` (Hash and Threads) and `quit`.
+ *
+ * @param in Stream to read commands from.
+ * @param out Stream to output responses, search info and best moves to.
+ */
+void uci_loop(std::istream &in, std::ostream &out);
+
+#endif
\ No newline at end of file
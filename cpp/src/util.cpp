@@ -1,5 +1,6 @@
 #include "util.h"
 
+#include <algorithm>
 #include <cmath>
 
 Coordinate uci_to_coordinate(const std::string &coordinate) {
@@ -77,20 +78,8 @@ Move uci_to_move(const std::string &move, const Piece::Type piece_type,
 }
 
 std::string move_to_uci(const Move &move) {
-  std::unordered_map<int, char> file_dict;
-  file_dict[0] = 'a';
-  file_dict[1] = 'b';
-  file_dict[2] = 'c';
-  file_dict[3] = 'd';
-  file_dict[4] = 'e';
-  file_dict[5] = 'f';
-  file_dict[6] = 'g';
-  file_dict[7] = 'h';
-
-  std::string move_string = file_dict[move.get_from().get_file()] +
-                            std::to_string(move.get_from().get_rank() + 1) +
-                            file_dict[move.get_dest().get_file()] +
-                            std::to_string(move.get_dest().get_rank() + 1);
+  std::string move_string = coordinate_to_uci(move.get_from()) +
+                            coordinate_to_uci(move.get_dest());
 
   switch (move.get_type()) {
   case Move::MoveType::KNIGHT_PROMOTION:
@@ -113,16 +102,15 @@ std::string move_to_uci(const Move &move) {
 }
 
 std::string coordinate_to_uci(const Coordinate &coordinate) {
-  std::unordered_map<int, char> file_dict;
-  file_dict[0] = 'a';
-  file_dict[1] = 'b';
-  file_dict[2] = 'c';
-  file_dict[3] = 'd';
-  file_dict[4] = 'e';
-  file_dict[5] = 'f';
-  file_dict[6] = 'g';
-  file_dict[7] = 'h';
+  return {char('a' + coordinate.get_file()),
+          char('1' + coordinate.get_rank())};
+}
 
-  return file_dict[coordinate.get_file()] +
-         std::to_string(coordinate.get_rank() + 1);
+std::string_view epd_position(const std::string_view line) {
+  size_t end = 0;
+  for (int field = 0; field < 4 && end < line.size(); ++field) {
+    end = line.find_first_not_of(' ', end);
+    end = std::min(line.find(' ', end), line.size());
+  }
+  return line.substr(0, end);
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "piece.h"
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 /**
@@ -43,4 +44,13 @@ std::string move_to_uci(const Move &move);
  */
 std::string coordinate_to_uci(const Coordinate &coordinate);
 
+/**
+ * Finds the position of an EPD line, the first four fields of a FEN string
+ * followed by operations.
+ *
+ * @param line EPD line.
+ * @return Part of `line` up to the end of its fourth field.
+ */
+std::string_view epd_position(const std::string_view line);
+
 #endif
\ No newline at end of file
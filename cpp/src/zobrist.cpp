@@ -0,0 +1,38 @@
+#include "zobrist.h"
+
+uint64_t zobrist_pieces[2][6][64];
+uint64_t zobrist_castling[16];
+uint64_t zobrist_empassant[8];
+uint64_t zobrist_side;
+
+/**
+ * Generates the next value of a xorshift64* sequence.
+ *
+ * @param state Generator state, updated in place. Must not be zero.
+ * @return Next pseudo-random value.
+ */
+static uint64_t next_random(uint64_t &state) {
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return state * 0x2545F4914F6CDD1DULL;
+}
+
+void init_zobrist() {
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+  for (int color = 0; color < 2; ++color) {
+    for (int type = 0; type < 6; ++type) {
+      for (int square = 0; square < 64; ++square) {
+        zobrist_pieces[color][type][square] = next_random(state);
+      }
+    }
+  }
+  for (int rights = 0; rights < 16; ++rights) {
+    zobrist_castling[rights] = next_random(state);
+  }
+  for (int file = 0; file < 8; ++file) {
+    zobrist_empassant[file] = next_random(state);
+  }
+  zobrist_side = next_random(state);
+}
\ No newline at end of file
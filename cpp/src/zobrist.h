@@ -0,0 +1,24 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+/// Random keys of each piece on each square, indexed by color, type, square.
+extern uint64_t zobrist_pieces[2][6][64];
+
+/// Random keys of each combination of castling right flags.
+extern uint64_t zobrist_castling[16];
+
+/// Random keys of the file of a capturable em passant target.
+extern uint64_t zobrist_empassant[8];
+
+/// Random key toggled when black is to move.
+extern uint64_t zobrist_side;
+
+/**
+ * Fills the Zobrist keys from a fixed seed, so keys are identical between
+ * runs. Must be called once at startup before any board is used.
+ */
+void init_zobrist();
+
+#endif
\ No newline at end of file